@@ -68,6 +68,17 @@ FetchContent_Declare(
     OVERRIDE_FIND_PACKAGE
 )
 
+set(LZ4_BUILD_CLI OFF CACHE BOOL "" FORCE)
+set(LZ4_BUILD_LEGACY_LZ4C OFF CACHE BOOL "" FORCE)
+set(BUILD_STATIC_LIBS ON CACHE BOOL "" FORCE)
+
+FetchContent_Declare(
+    lz4
+    GIT_REPOSITORY https://github.com/lz4/lz4.git
+    GIT_TAG        v1.10.0
+    SOURCE_SUBDIR  build/cmake
+)
+
 FetchContent_Declare(
   nlohmann_json
   GIT_REPOSITORY https://github.com/nlohmann/json.git
@@ -144,7 +155,7 @@ set(HTTPLIB_COMPILE OFF CACHE BOOL "" FORCE)
 set(HTTPLIB_TEST OFF CACHE BOOL "" FORCE)
 set(HTTPLIB_EXAMPLE OFF CACHE BOOL "" FORCE)
 
-FetchContent_MakeAvailable(zlib zstd)
+FetchContent_MakeAvailable(zlib zstd lz4)
 
 target_include_directories(libzstd_static INTERFACE
     $<BUILD_INTERFACE:${zstd_SOURCE_DIR}/lib>
@@ -154,6 +165,14 @@ if(NOT TARGET zstd::libzstd)
     add_library(zstd::libzstd ALIAS libzstd_static)
 endif()
 
+target_include_directories(lz4_static INTERFACE
+    $<BUILD_INTERFACE:${lz4_SOURCE_DIR}/lib>
+)
+
+if(NOT TARGET lz4::lz4)
+    add_library(lz4::lz4 ALIAS lz4_static)
+endif()
+
 FetchContent_MakeAvailable(Auxid pugixml nlohmann_json glaze simdjson unordered_dense mimalloc highway)
 
 if(NOT TARGET simdjson::simdjson)
@@ -162,3 +181,4 @@ endif()
 
 target_compile_options(hwy PRIVATE -w)
 target_compile_options(libzstd_static PRIVATE -w)
+target_compile_options(lz4_static PRIVATE -w)
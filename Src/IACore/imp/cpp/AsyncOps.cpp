@@ -15,55 +15,414 @@
 
 #include <IACore/AsyncOps.hpp>
 
+#include <algorithm>
+#include <chrono>
+#include <deque>
+#include <iterator>
+
+#if IA_PLATFORM_UNIX
+#  include <pthread.h>
+#endif
+
 namespace IACore
 {
-  Mut<std::mutex> AsyncOps::s_queue_mutex;
-  Mut<std::condition_variable> AsyncOps::s_wake_condition;
-  Mut<Vec<std::jthread>> AsyncOps::s_schedule_workers;
-  Mut<std::deque<AsyncOps::ScheduledTask>> AsyncOps::s_high_priority_queue;
-  Mut<std::deque<AsyncOps::ScheduledTask>> AsyncOps::s_normal_priority_queue;
+  namespace
+  {
+    auto now_ns() -> u64
+    {
+      return static_cast<u64>(
+          std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch())
+              .count());
+    }
+
+    auto ticks_since(const std::chrono::steady_clock::time_point epoch) -> u64
+    {
+      return static_cast<u64>(
+          std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - epoch).count());
+    }
+
+    struct BlockingPool
+    {
+      Mut<std::mutex> mutex;
+      Mut<std::condition_variable> condition;
+      Mut<std::deque<std::function<void()>>> queue;
+      Mut<AsyncOps::BlockingPoolConfig> config;
+      Mut<u32> thread_count{0};
+      Mut<u32> idle_count{0};
+    };
+
+    // Intentionally never destroyed: like detached threads, blocking tasks may outlive main()
+    auto blocking_pool() -> MutRef<BlockingPool>
+    {
+      static BlockingPool *const pool = new BlockingPool();
+      return *pool;
+    }
+
+    auto blocking_worker_loop() -> void
+    {
+      MutRef<BlockingPool> pool = blocking_pool();
+
+      Mut<std::unique_lock<std::mutex>> lock(pool.mutex);
+      while (true)
+      {
+        // Shrink right away if the pool was reconfigured below the current size
+        if (pool.thread_count > pool.config.max_threads)
+        {
+          pool.thread_count--;
+          return;
+        }
+
+        if (pool.queue.empty())
+        {
+          pool.idle_count++;
+          const bool woken = pool.condition.wait_for(
+              lock, std::chrono::milliseconds(pool.config.idle_timeout_ms),
+              [&pool] { return !pool.queue.empty() || pool.thread_count > pool.config.max_threads; });
+          pool.idle_count--;
+
+          if (!woken && pool.thread_count > pool.config.core_threads)
+          {
+            pool.thread_count--;
+            return;
+          }
+          continue;
+        }
+
+        Mut<std::function<void()>> task = std::move(pool.queue.front());
+        pool.queue.pop_front();
+
+        lock.unlock();
+        task();
+        lock.lock();
+      }
+    }
+
+    // Best effort, names longer than the platform limit are truncated
+    auto set_current_thread_name(Ref<String> name) -> void
+    {
+#if IA_PLATFORM_WINDOWS
+      const std::wstring wide_name(name.begin(), name.end());
+      ::SetThreadDescription(::GetCurrentThread(), wide_name.c_str());
+#elif IA_PLATFORM_LINUX
+      ::pthread_setname_np(::pthread_self(), name.substr(0, 15).c_str());
+#elif IA_PLATFORM_APPLE
+      ::pthread_setname_np(name.substr(0, 63).c_str());
+#else
+      AU_UNUSED(name);
+#endif
+    }
+
+    auto pin_thread(MutRef<std::jthread> thread, const u32 cpu) -> Result<void>
+    {
+#if IA_PLATFORM_WINDOWS
+      if (cpu >= 64)
+      {
+        return fail("Cannot pin to CPU {}, processor groups are not supported", cpu);
+      }
+      if (::SetThreadAffinityMask(static_cast<HANDLE>(thread.native_handle()), 1ull << cpu) == 0)
+      {
+        return fail("SetThreadAffinityMask failed for CPU {} ({})", cpu, ::GetLastError());
+      }
+#elif IA_PLATFORM_LINUX
+      Mut<cpu_set_t> cpu_set;
+      CPU_ZERO(&cpu_set);
+      CPU_SET(cpu, &cpu_set);
+      const i32 result = ::pthread_setaffinity_np(thread.native_handle(), sizeof(cpu_set), &cpu_set);
+      if (result != 0)
+      {
+        return fail("pthread_setaffinity_np failed for CPU {} ({})", cpu, result);
+      }
+#else
+      // No hard affinity on Apple or WASM, placement is left to the OS
+      AU_UNUSED(thread);
+      AU_UNUSED(cpu);
+#endif
+      return {};
+    }
+
+    auto atomic_max(MutRef<std::atomic<u64>> target, const u64 value) -> void
+    {
+      Mut<u64> current = target.load(std::memory_order_relaxed);
+      while (current < value && !target.compare_exchange_weak(current, value, std::memory_order_relaxed))
+      {
+      }
+    }
+
+    // Appends `value` as the contents of a JSON string literal
+    auto append_json_escaped(MutRef<String> out, const StringView value) -> void
+    {
+      for (const char c : value)
+      {
+        switch (c)
+        {
+        case '"':
+          out += "\\\"";
+          break;
+        case '\\':
+          out += "\\\\";
+          break;
+        case '\n':
+          out += "\\n";
+          break;
+        case '\r':
+          out += "\\r";
+          break;
+        case '\t':
+          out += "\\t";
+          break;
+        default:
+          if (static_cast<u8>(c) < 0x20)
+          {
+            std::format_to(std::back_inserter(out), "\\u{:04x}", static_cast<u8>(c));
+          }
+          else
+          {
+            out += c;
+          }
+        }
+      }
+    }
+  } // namespace
 
   auto AsyncOps::run_task(Mut<std::function<void()>> task) -> void
   {
-    std::jthread(std::move(task)).detach();
+    MutRef<BlockingPool> pool = blocking_pool();
+
+    Mut<bool> spawn_thread = false;
+    {
+      const std::lock_guard<std::mutex> lock(pool.mutex);
+      pool.queue.push_back(std::move(task));
+
+      // Grow only when the idle threads can't absorb the backlog
+      if (pool.idle_count < pool.queue.size() && pool.thread_count < pool.config.max_threads)
+      {
+        pool.thread_count++;
+        spawn_thread = true;
+      }
+    }
+
+    if (spawn_thread)
+    {
+      std::jthread(blocking_worker_loop).detach();
+    }
+    else
+    {
+      pool.condition.notify_one();
+    }
+  }
+
+  auto AsyncOps::configure_blocking_pool(Ref<BlockingPoolConfig> config) -> void
+  {
+    MutRef<BlockingPool> pool = blocking_pool();
+    {
+      const std::lock_guard<std::mutex> lock(pool.mutex);
+      pool.config = config;
+      pool.config.max_threads = std::max<u32>(pool.config.max_threads, 1);
+      pool.config.core_threads = std::min(pool.config.core_threads, pool.config.max_threads);
+    }
+    pool.condition.notify_all();
+  }
+
+  auto AsyncOps::get_blocking_pool_thread_count() -> u32
+  {
+    MutRef<BlockingPool> pool = blocking_pool();
+    const std::lock_guard<std::mutex> lock(pool.mutex);
+    return pool.thread_count;
   }
 
-  auto AsyncOps::initialize_scheduler(Mut<u8> worker_count) -> Result<void>
+  auto AsyncOps::default_scheduler() -> MutRef<Scheduler>
   {
+    static Scheduler scheduler;
+    return scheduler;
+  }
+
+  auto AsyncOps::initialize_scheduler(const u8 worker_count) -> Result<void>
+  {
+    return default_scheduler().start(SchedulerConfig{.worker_count = worker_count});
+  }
+
+  auto AsyncOps::terminate_scheduler() -> void
+  {
+    default_scheduler().stop();
+  }
+
+  auto AsyncOps::schedule_task(Mut<std::function<void(const WorkerId)>> task, const TaskTag tag, Schedule *schedule,
+                               const Priority priority) -> void
+  {
+    default_scheduler().schedule_task(std::move(task), tag, schedule, priority);
+  }
+
+  auto AsyncOps::cancel_tasks_of_tag(const TaskTag tag) -> void
+  {
+    default_scheduler().cancel_tasks_of_tag(tag);
+  }
+
+  auto AsyncOps::wait_for_schedule_completion(Schedule *schedule) -> void
+  {
+    default_scheduler().wait_for_schedule_completion(schedule);
+  }
+
+  auto AsyncOps::schedule_after(const u64 delay_ms, Mut<std::function<void(const WorkerId)>> task, const TaskTag tag,
+                                Schedule *schedule, const Priority priority) -> TimerHandle
+  {
+    return default_scheduler().schedule_after(delay_ms, std::move(task), tag, schedule, priority);
+  }
+
+  auto AsyncOps::schedule_every(const u64 interval_ms, Mut<std::function<void(const WorkerId)>> task,
+                                const TaskTag tag, const Priority priority) -> TimerHandle
+  {
+    return default_scheduler().schedule_every(interval_ms, std::move(task), tag, priority);
+  }
+
+  auto AsyncOps::cancel_timer(const TimerHandle handle) -> bool
+  {
+    return default_scheduler().cancel_timer(handle);
+  }
+
+  auto AsyncOps::get_worker_count() -> WorkerId
+  {
+    return default_scheduler().get_worker_count();
+  }
+
+  auto AsyncOps::get_worker_stats(const WorkerId worker_id) -> WorkerStats
+  {
+    return default_scheduler().get_worker_stats(worker_id);
+  }
+
+  auto AsyncOps::reset_worker_stats() -> void
+  {
+    default_scheduler().reset_worker_stats();
+  }
+
+  auto AsyncOps::enable_tracing(const usize events_per_worker) -> void
+  {
+    default_scheduler().enable_tracing(events_per_worker);
+  }
+
+  auto AsyncOps::disable_tracing() -> void
+  {
+    default_scheduler().disable_tracing();
+  }
+
+  auto AsyncOps::get_trace_events() -> Vec<TraceEvent>
+  {
+    return default_scheduler().get_trace_events();
+  }
+
+  auto AsyncOps::export_chrome_trace() -> String
+  {
+    return default_scheduler().export_chrome_trace();
+  }
+
+  auto AsyncOps::Scheduler::create(Ref<SchedulerConfig> config) -> Result<Box<Scheduler>>
+  {
+    Mut<Box<Scheduler>> scheduler = make_box<Scheduler>();
+    AU_TRY_PURE(scheduler->start(config));
+    return scheduler;
+  }
+
+  AsyncOps::Scheduler::~Scheduler()
+  {
+    stop();
+  }
+
+  auto AsyncOps::Scheduler::start(Ref<SchedulerConfig> config) -> Result<void>
+  {
+    if (is_running())
+    {
+      return fail("Scheduler '{}' is already running", m_name);
+    }
+
+    const u32 hw_concurrency = std::thread::hardware_concurrency();
+
+    Mut<u32> worker_count = config.worker_count;
     if (worker_count == 0)
     {
-      const u32 hw_concurrency = std::thread::hardware_concurrency();
-      Mut<u32> threads = 2;
+      worker_count = 2;
       if (hw_concurrency > 2)
       {
-        threads = hw_concurrency - 2;
+        worker_count = std::min<u32>(hw_concurrency - 2, 255);
       }
+    }
 
-      if (threads > 255)
+    for (const u32 cpu : config.pinned_cpus)
+    {
+      if (hw_concurrency != 0 && cpu >= hw_concurrency)
       {
-        threads = 255;
+        return fail("Cannot pin to CPU {}, only {} are available", cpu, hw_concurrency);
       }
-      worker_count = static_cast<u8>(threads);
     }
 
+    m_name = config.name;
+
+    m_worker_states.clear();
+    for (Mut<u32> i = 0; i <= worker_count; ++i)
+    {
+      m_worker_states.push_back(make_box<WorkerState>());
+    }
+
+    {
+      const std::lock_guard<std::mutex> lock(m_trace_mutex);
+      m_trace_rings.clear();
+      install_trace_rings(m_trace_capacity);
+    }
+
+    m_workers.reserve(worker_count);
     for (Mut<u32> i = 0; i < worker_count; ++i)
     {
-      s_schedule_workers.emplace_back(schedule_worker_loop, static_cast<WorkerId>(i + 1));
+      m_workers.emplace_back([this](const std::stop_token stop_token, const WorkerId worker_id) {
+        worker_loop(stop_token, worker_id);
+      }, static_cast<WorkerId>(i + 1));
+
+      if (!config.pinned_cpus.empty())
+      {
+        const Result<void> pinned = pin_thread(m_workers.back(), config.pinned_cpus[i % config.pinned_cpus.size()]);
+        if (!pinned)
+        {
+          stop();
+          return fail("{}", pinned.error());
+        }
+      }
+    }
+
+    {
+      const std::lock_guard<std::mutex> lock(m_timer_mutex);
+      m_timer_wheel = TimerWheel<TimerEntry>();
+      m_timer_epoch = std::chrono::steady_clock::now();
+      m_timer_wake_tick = 0;
     }
+    m_timer_thread = std::jthread([this](const std::stop_token stop_token) { timer_loop(stop_token); });
 
     return {};
   }
 
-  auto AsyncOps::terminate_scheduler() -> void
+  auto AsyncOps::Scheduler::stop() -> void
   {
-    for (MutRef<std::jthread> worker : s_schedule_workers)
+    // Stop the timer thread first so nothing is queued behind the workers' backs
+    if (m_timer_thread.joinable())
+    {
+      m_timer_thread.request_stop();
+      m_timer_thread.join();
+    }
+
+    {
+      const std::lock_guard<std::mutex> lock(m_timer_mutex);
+      m_timer_wheel.drain([](MutRef<TimerEntry> entry) {
+        if (entry.interval_ms == 0 && entry.schedule_handle && entry.schedule_handle->counter.fetch_sub(1) == 1)
+        {
+          entry.schedule_handle->counter.notify_all();
+        }
+      });
+    }
+
+    for (MutRef<std::jthread> worker : m_workers)
     {
       worker.request_stop();
     }
 
-    s_wake_condition.notify_all();
+    m_wake_condition.notify_all();
 
-    for (MutRef<std::jthread> worker : s_schedule_workers)
+    for (MutRef<std::jthread> worker : m_workers)
     {
       if (worker.joinable())
       {
@@ -71,35 +430,109 @@ namespace IACore
       }
     }
 
-    s_schedule_workers.clear();
+    m_workers.clear();
   }
 
-  auto AsyncOps::schedule_task(Mut<std::function<void(WorkerId worker_id)>> task, const TaskTag tag, Schedule *schedule,
-                               const Priority priority) -> void
+  auto AsyncOps::Scheduler::schedule_task(Mut<std::function<void(const WorkerId)>> task, const TaskTag tag,
+                                          Schedule *schedule, const Priority priority) -> void
   {
-    ensure(!s_schedule_workers.empty(), "Scheduler must be initialized before calling schedule_task");
+    ensure(!m_workers.empty(), "Scheduler must be initialized before calling schedule_task");
 
     schedule->counter.fetch_add(1);
     {
-      const std::lock_guard<std::mutex> lock(s_queue_mutex);
+      const std::lock_guard<std::mutex> lock(m_queue_mutex);
       if (priority == Priority::High)
       {
-        s_high_priority_queue.emplace_back(ScheduledTask{tag, schedule, std::move(task)});
+        m_high_priority_queue.emplace_back(ScheduledTask{tag, schedule, std::move(task)});
       }
       else
       {
-        s_normal_priority_queue.emplace_back(ScheduledTask{tag, schedule, std::move(task)});
+        m_normal_priority_queue.emplace_back(ScheduledTask{tag, schedule, std::move(task)});
       }
     }
-    s_wake_condition.notify_one();
+    m_wake_condition.notify_one();
   }
 
-  auto AsyncOps::cancel_tasks_of_tag(const TaskTag tag) -> void
+  auto AsyncOps::Scheduler::schedule_after(const u64 delay_ms, Mut<std::function<void(const WorkerId)>> task,
+                                           const TaskTag tag, Schedule *schedule, const Priority priority)
+      -> TimerHandle
   {
-    const std::lock_guard<std::mutex> lock(s_queue_mutex);
+    ensure(!m_workers.empty(), "Scheduler must be initialized before calling schedule_after");
 
+    if (schedule)
     {
-      MutRef<std::deque<ScheduledTask>> queue = s_high_priority_queue;
+      schedule->counter.fetch_add(1);
+    }
+
+    return arm_timer(delay_ms, TimerEntry{tag, schedule, priority, 0, std::move(task)});
+  }
+
+  auto AsyncOps::Scheduler::schedule_every(const u64 interval_ms, Mut<std::function<void(const WorkerId)>> task,
+                                           const TaskTag tag, const Priority priority) -> TimerHandle
+  {
+    ensure(!m_workers.empty(), "Scheduler must be initialized before calling schedule_every");
+
+    const u64 interval = std::max<u64>(interval_ms, 1);
+    return arm_timer(interval, TimerEntry{tag, nullptr, priority, interval, std::move(task)});
+  }
+
+  auto AsyncOps::Scheduler::cancel_timer(const TimerHandle handle) -> bool
+  {
+    Mut<Option<TimerEntry>> entry;
+    {
+      const std::lock_guard<std::mutex> lock(m_timer_mutex);
+      entry = m_timer_wheel.cancel(handle);
+    }
+
+    if (!entry)
+    {
+      return false;
+    }
+
+    if (entry->interval_ms == 0 && entry->schedule_handle && entry->schedule_handle->counter.fetch_sub(1) == 1)
+    {
+      entry->schedule_handle->counter.notify_all();
+    }
+
+    return true;
+  }
+
+  auto AsyncOps::Scheduler::arm_timer(const u64 delay_ms, Mut<TimerEntry> entry) -> TimerHandle
+  {
+    Mut<TimerHandle> handle = INVALID_TIMER_HANDLE;
+    Mut<bool> wake_timer_thread = false;
+    {
+      const std::lock_guard<std::mutex> lock(m_timer_mutex);
+
+      // Round up so the timer never fires before `delay_ms` has fully elapsed
+      const u64 expiry_tick =
+          static_cast<u64>(
+              std::chrono::ceil<std::chrono::milliseconds>(std::chrono::steady_clock::now() - m_timer_epoch).count()) +
+          delay_ms;
+      handle = m_timer_wheel.schedule(expiry_tick, std::move(entry));
+
+      // Only interrupt the timer thread's sleep if this timer is due before it would wake anyway
+      if (expiry_tick < m_timer_wake_tick)
+      {
+        m_timer_wake_tick = expiry_tick;
+        wake_timer_thread = true;
+      }
+    }
+
+    if (wake_timer_thread)
+    {
+      m_timer_condition.notify_one();
+    }
+
+    return handle;
+  }
+
+  auto AsyncOps::Scheduler::cancel_tasks_of_tag(const TaskTag tag) -> void
+  {
+    const std::lock_guard<std::mutex> lock(m_queue_mutex);
+
+    {
+      MutRef<std::deque<ScheduledTask>> queue = m_high_priority_queue;
       for (Mut<std::deque<ScheduledTask>::iterator> it = queue.begin(); it != queue.end();
            /* no incr */)
       {
@@ -119,7 +552,7 @@ namespace IACore
     }
 
     {
-      MutRef<std::deque<ScheduledTask>> queue = s_normal_priority_queue;
+      MutRef<std::deque<ScheduledTask>> queue = m_normal_priority_queue;
       for (Mut<std::deque<ScheduledTask>::iterator> it = queue.begin(); it != queue.end();
            /* no incr */)
       {
@@ -139,94 +572,380 @@ namespace IACore
     }
   }
 
-  auto AsyncOps::wait_for_schedule_completion(Schedule *schedule) -> void
+  auto AsyncOps::Scheduler::wait_for_schedule_completion(Schedule *schedule) -> void
   {
-    ensure(!s_schedule_workers.empty(), "Scheduler must be initialized before "
-                                        "calling wait_for_schedule_completion");
+    ensure(!m_workers.empty(), "Scheduler must be initialized before "
+                               "calling wait_for_schedule_completion");
+
+    MutRef<WorkerState> state = *m_worker_states[MAIN_THREAD_WORKER_ID];
 
     while (schedule->counter.load() > 0)
     {
       Mut<ScheduledTask> task;
       Mut<bool> found_task = false;
       {
-        Mut<std::unique_lock<std::mutex>> lock(s_queue_mutex);
-        if (!s_high_priority_queue.empty())
-        {
-          task = std::move(s_high_priority_queue.front());
-          s_high_priority_queue.pop_front();
-          found_task = true;
-        }
-        else if (!s_normal_priority_queue.empty())
-        {
-          task = std::move(s_normal_priority_queue.front());
-          s_normal_priority_queue.pop_front();
-          found_task = true;
-        }
+        Mut<std::unique_lock<std::mutex>> lock = lock_queue(state);
+        found_task = pop_task_locked(state, task);
       }
 
       if (found_task)
       {
-        task.task(MAIN_THREAD_WORKER_ID);
-        if (task.schedule_handle->counter.fetch_sub(1) == 1)
-        {
-          task.schedule_handle->counter.notify_all();
-        }
+        execute_task(state, task, MAIN_THREAD_WORKER_ID);
       }
       else
       {
         const u32 current_val = schedule->counter.load();
         if (current_val > 0)
         {
+          const u64 idle_start = now_ns();
           schedule->counter.wait(current_val);
+          state.idle_ns.fetch_add(now_ns() - idle_start, std::memory_order_relaxed);
         }
       }
     }
   }
 
-  auto AsyncOps::get_worker_count() -> WorkerId
+  auto AsyncOps::Scheduler::get_worker_count() const -> WorkerId
+  {
+    return static_cast<WorkerId>(m_workers.size());
+  }
+
+  auto AsyncOps::Scheduler::get_worker_stats(const WorkerId worker_id) const -> WorkerStats
+  {
+    if (worker_id >= m_worker_states.size())
+    {
+      return {};
+    }
+
+    Ref<WorkerState> state = *m_worker_states[worker_id];
+    return WorkerStats{
+        .tasks_run = state.tasks_run.load(std::memory_order_relaxed),
+        .busy_ns = state.busy_ns.load(std::memory_order_relaxed),
+        .idle_ns = state.idle_ns.load(std::memory_order_relaxed),
+        .lock_contentions = state.lock_contentions.load(std::memory_order_relaxed),
+        .queue_depth_high_water = state.queue_depth_high_water.load(std::memory_order_relaxed),
+    };
+  }
+
+  auto AsyncOps::Scheduler::reset_worker_stats() -> void
+  {
+    for (MutRef<Box<WorkerState>> state : m_worker_states)
+    {
+      state->tasks_run.store(0, std::memory_order_relaxed);
+      state->busy_ns.store(0, std::memory_order_relaxed);
+      state->idle_ns.store(0, std::memory_order_relaxed);
+      state->lock_contentions.store(0, std::memory_order_relaxed);
+      state->queue_depth_high_water.store(0, std::memory_order_relaxed);
+    }
+  }
+
+  auto AsyncOps::Scheduler::enable_tracing(const usize events_per_worker) -> void
+  {
+    m_tracing_enabled.store(false, std::memory_order_release);
+
+    const std::lock_guard<std::mutex> lock(m_trace_mutex);
+
+    // Same capacity keeps the current rings, the new epoch hides the events recorded before it
+    if (events_per_worker != m_trace_capacity)
+    {
+      m_trace_capacity = events_per_worker;
+      install_trace_rings(events_per_worker);
+    }
+
+    m_trace_epoch_ns.store(now_ns(), std::memory_order_relaxed);
+    m_tracing_enabled.store(events_per_worker > 0, std::memory_order_release);
+  }
+
+  auto AsyncOps::Scheduler::disable_tracing() -> void
+  {
+    m_tracing_enabled.store(false, std::memory_order_release);
+  }
+
+  auto AsyncOps::Scheduler::get_trace_events() -> Vec<TraceEvent>
+  {
+    Mut<Vec<TraceEvent>> events;
+
+    const std::lock_guard<std::mutex> lock(m_trace_mutex);
+    const u64 epoch_ns = m_trace_epoch_ns.load(std::memory_order_relaxed);
+
+    for (Mut<usize> worker_id = 0; worker_id < m_worker_states.size(); ++worker_id)
+    {
+      const TraceRing *ring = m_worker_states[worker_id]->trace_ring.load(std::memory_order_acquire);
+      if (!ring)
+      {
+        continue;
+      }
+
+      const usize capacity = ring->slots.size();
+      const u64 head = ring->head.load(std::memory_order_acquire);
+      const u64 count = std::min<u64>(head, capacity);
+      for (Mut<u64> i = head - count; i < head; ++i)
+      {
+        Ref<TraceSlot> slot = ring->slots[static_cast<usize>(i % capacity)];
+
+        const u64 sequence = slot.sequence.load(std::memory_order_acquire);
+        if (sequence != 2 * i + 2)
+        {
+          continue; // Still being written, or already overwritten by a later event
+        }
+
+        const TraceEvent event{slot.tag.load(std::memory_order_acquire), static_cast<WorkerId>(worker_id),
+                               slot.begin_ns.load(std::memory_order_acquire),
+                               slot.end_ns.load(std::memory_order_acquire)};
+
+        if (slot.sequence.load(std::memory_order_relaxed) != sequence || event.begin_ns < epoch_ns)
+        {
+          continue;
+        }
+
+        events.push_back(
+            TraceEvent{event.tag, event.worker_id, event.begin_ns - epoch_ns, event.end_ns - epoch_ns});
+      }
+    }
+
+    std::ranges::sort(events, [](Ref<TraceEvent> a, Ref<TraceEvent> b) { return a.begin_ns < b.begin_ns; });
+
+    return events;
+  }
+
+  auto AsyncOps::Scheduler::export_chrome_trace() -> String
+  {
+    const Vec<TraceEvent> events = get_trace_events();
+
+    Mut<String> out;
+    out.reserve(128 + events.size() * 128);
+    out += R"({"displayTimeUnit":"ns","traceEvents":[)";
+
+    for (Mut<usize> i = 0; i < m_worker_states.size(); ++i)
+    {
+      if (i > 0)
+      {
+        out += ',';
+      }
+
+      if (i == MAIN_THREAD_WORKER_ID)
+      {
+        std::format_to(std::back_inserter(out),
+                       R"({{"name":"thread_name","ph":"M","pid":1,"tid":{},"args":{{"name":"Main Thread"}}}})", i);
+      }
+      else
+      {
+        std::format_to(std::back_inserter(out), R"({{"name":"thread_name","ph":"M","pid":1,"tid":{},"args":{{"name":")",
+                       i);
+        append_json_escaped(out, m_name);
+        std::format_to(std::back_inserter(out), R"( {}"}}}})", i);
+      }
+    }
+
+    for (Ref<TraceEvent> event : events)
+    {
+      std::format_to(std::back_inserter(out),
+                     R"(,{{"name":"Task {}","cat":"AsyncOps","ph":"X","pid":1,"tid":{},"ts":{:.3f},"dur":{:.3f},)"
+                     R"("args":{{"tag":{}}}}})",
+                     event.tag, event.worker_id, static_cast<f64>(event.begin_ns) / 1000.0,
+                     static_cast<f64>(event.end_ns - event.begin_ns) / 1000.0, event.tag);
+    }
+
+    out += "]}";
+    return out;
+  }
+
+  auto AsyncOps::Scheduler::lock_queue(MutRef<WorkerState> state) -> std::unique_lock<std::mutex>
+  {
+    Mut<std::unique_lock<std::mutex>> lock(m_queue_mutex, std::try_to_lock);
+    if (!lock.owns_lock())
+    {
+      state.lock_contentions.fetch_add(1, std::memory_order_relaxed);
+      lock.lock();
+    }
+    return lock;
+  }
+
+  auto AsyncOps::Scheduler::pop_task_locked(MutRef<WorkerState> state, MutRef<ScheduledTask> out_task) -> bool
+  {
+    const usize depth = m_high_priority_queue.size() + m_normal_priority_queue.size();
+    if (depth == 0)
+    {
+      return false;
+    }
+
+    atomic_max(state.queue_depth_high_water, depth);
+
+    if (!m_high_priority_queue.empty())
+    {
+      out_task = std::move(m_high_priority_queue.front());
+      m_high_priority_queue.pop_front();
+    }
+    else
+    {
+      out_task = std::move(m_normal_priority_queue.front());
+      m_normal_priority_queue.pop_front();
+    }
+    return true;
+  }
+
+  auto AsyncOps::Scheduler::execute_task(MutRef<WorkerState> state, MutRef<ScheduledTask> task,
+                                         const WorkerId worker_id) -> void
+  {
+    const u64 begin_ns = now_ns();
+    task.task(worker_id);
+    const u64 end_ns = now_ns();
+
+    state.tasks_run.fetch_add(1, std::memory_order_relaxed);
+    state.busy_ns.fetch_add(end_ns - begin_ns, std::memory_order_relaxed);
+
+    if (m_tracing_enabled.load(std::memory_order_acquire))
+    {
+      Mut<TraceRing *> ring = state.trace_ring.load(std::memory_order_acquire);
+      if (ring)
+      {
+        // Each worker is the only writer of its ring, except for the main thread's which every caller of
+        // wait_for_schedule_completion shares, hence reserving the index with fetch_add
+        const u64 index = ring->head.fetch_add(1, std::memory_order_relaxed);
+        MutRef<TraceSlot> slot = ring->slots[static_cast<usize>(index % ring->slots.size())];
+
+        // Release on the fields keeps the odd sequence ordered before them for any reader that sees them
+        slot.sequence.store(2 * index + 1, std::memory_order_relaxed);
+        slot.tag.store(task.tag, std::memory_order_release);
+        slot.begin_ns.store(begin_ns, std::memory_order_release);
+        slot.end_ns.store(end_ns, std::memory_order_release);
+        slot.sequence.store(2 * index + 2, std::memory_order_release);
+      }
+    }
+
+    if (task.schedule_handle->counter.fetch_sub(1) == 1)
+    {
+      task.schedule_handle->counter.notify_all();
+    }
+  }
+
+  auto AsyncOps::Scheduler::install_trace_rings(const usize capacity) -> void
   {
-    return static_cast<WorkerId>(s_schedule_workers.size());
+    for (MutRef<Box<WorkerState>> state : m_worker_states)
+    {
+      if (capacity == 0)
+      {
+        state->trace_ring.store(nullptr, std::memory_order_release);
+        continue;
+      }
+
+      Mut<Box<TraceRing>> ring = make_box<TraceRing>();
+      ring->slots = Vec<TraceSlot>(capacity);
+      state->trace_ring.store(ring.get(), std::memory_order_release);
+      m_trace_rings.push_back(std::move(ring));
+    }
   }
 
-  auto AsyncOps::schedule_worker_loop(const std::stop_token stop_token, const WorkerId worker_id) -> void
+  auto AsyncOps::Scheduler::worker_loop(const std::stop_token stop_token, const WorkerId worker_id) -> void
   {
+    set_current_thread_name(std::format("{} {}", m_name, worker_id));
+
+    MutRef<WorkerState> state = *m_worker_states[worker_id];
+
     while (!stop_token.stop_requested())
     {
       Mut<ScheduledTask> task;
       Mut<bool> found_task = false;
       {
-        Mut<std::unique_lock<std::mutex>> lock(s_queue_mutex);
+        const u64 idle_start = now_ns();
+
+        Mut<std::unique_lock<std::mutex>> lock = lock_queue(state);
 
-        s_wake_condition.wait(lock, [&stop_token] {
-          return !s_high_priority_queue.empty() || !s_normal_priority_queue.empty() || stop_token.stop_requested();
+        m_wake_condition.wait(lock, [this, &stop_token] {
+          return !m_high_priority_queue.empty() || !m_normal_priority_queue.empty() || stop_token.stop_requested();
         });
 
-        if (stop_token.stop_requested() && s_high_priority_queue.empty() && s_normal_priority_queue.empty())
+        state.idle_ns.fetch_add(now_ns() - idle_start, std::memory_order_relaxed);
+
+        if (stop_token.stop_requested() && m_high_priority_queue.empty() && m_normal_priority_queue.empty())
         {
           return;
         }
 
-        if (!s_high_priority_queue.empty())
+        found_task = pop_task_locked(state, task);
+      }
+
+      if (found_task)
+      {
+        execute_task(state, task, worker_id);
+      }
+    }
+  }
+
+  auto AsyncOps::Scheduler::timer_loop(const std::stop_token stop_token) -> void
+  {
+    set_current_thread_name(std::format("{} Timer", m_name));
+
+    Mut<Vec<std::pair<Priority, ScheduledTask>>> fired;
+
+    Mut<std::unique_lock<std::mutex>> lock(m_timer_mutex);
+    while (!stop_token.stop_requested())
+    {
+      // Awake, arm_timer doesn't need to notify until we go back to sleep
+      m_timer_wake_tick = 0;
+
+      const u64 now_tick = ticks_since(m_timer_epoch);
+      m_timer_wheel.advance(now_tick, [&](const TimerWheel<TimerEntry>::TimerId,
+                                          MutRef<TimerEntry> entry) -> Option<u64> {
+        if (entry.interval_ms == 0)
         {
-          task = std::move(s_high_priority_queue.front());
-          s_high_priority_queue.pop_front();
-          found_task = true;
+          fired.emplace_back(entry.priority, ScheduledTask{entry.tag, entry.schedule_handle, std::move(entry.task)});
+          return std::nullopt;
         }
-        else if (!s_normal_priority_queue.empty())
+
+        fired.emplace_back(entry.priority, ScheduledTask{entry.tag, nullptr, entry.task});
+
+        Mut<u64> next_tick = m_timer_wheel.current_tick() + entry.interval_ms;
+        if (next_tick <= now_tick)
         {
-          task = std::move(s_normal_priority_queue.front());
-          s_normal_priority_queue.pop_front();
-          found_task = true;
+          next_tick = now_tick + entry.interval_ms;
         }
-      }
+        return next_tick;
+      });
 
-      if (found_task)
+      if (!fired.empty())
       {
-        task.task(worker_id);
-        if (task.schedule_handle->counter.fetch_sub(1) == 1)
+        lock.unlock();
         {
-          task.schedule_handle->counter.notify_all();
+          const std::lock_guard<std::mutex> queue_lock(m_queue_mutex);
+          for (MutRef<std::pair<Priority, ScheduledTask>> item : fired)
+          {
+            MutRef<ScheduledTask> task = item.second;
+            if (!task.schedule_handle)
+            {
+              task.schedule_handle = &m_timer_schedule;
+              m_timer_schedule.counter.fetch_add(1);
+            }
+
+            if (item.first == Priority::High)
+            {
+              m_high_priority_queue.emplace_back(std::move(task));
+            }
+            else
+            {
+              m_normal_priority_queue.emplace_back(std::move(task));
+            }
+          }
         }
+        m_wake_condition.notify_all();
+        fired.clear();
+        lock.lock();
+        continue;
+      }
+
+      const Option<u64> next_tick = m_timer_wheel.next_event_tick();
+      const u64 planned_tick = next_tick.value_or(std::numeric_limits<u64>::max());
+      m_timer_wake_tick = planned_tick;
+
+      const auto woken_early = [this, planned_tick] { return m_timer_wake_tick != planned_tick; };
+      if (next_tick)
+      {
+        m_timer_condition.wait_until(lock, stop_token, m_timer_epoch + std::chrono::milliseconds(*next_tick),
+                                     woken_early);
+      }
+      else
+      {
+        m_timer_condition.wait(lock, stop_token, woken_early);
       }
     }
   }
@@ -13,12 +13,16 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <IACore/AsyncOps.hpp>
 #include <IACore/DataOps.hpp>
 #include <IACore/Platform.hpp>
+#include <IACore/StreamWriter.hpp>
 
 #include <bit>
 #include <cstring>
+#include <lz4frame.h>
 #include <zlib.h>
+#include <zdict.h>
 #include <zstd.h>
 
 #if IA_ARCH_X64
@@ -27,6 +31,7 @@
 
 #if IA_ARCH_ARM64
 #  include <arm_acle.h>
+#  include <arm_neon.h>
 #endif
 
 namespace IACore
@@ -69,14 +74,109 @@ namespace IACore
 
   static constexpr const Crc32Tables CRC32_TABLES{};
 
+  constexpr const u32 CRC32C_POLY = 0x82F63B78;
+
+  // GF(2) polynomial arithmetic modulo the CRC32C polynomial, in the reflected bit order
+  // the CRC register uses (bit 31 is x^0). Same scheme as zlib's crc32_combine.
+  constexpr auto crc32c_multmodp(Mut<u32> a, Mut<u32> b) -> u32
+  {
+    Mut<u32> m = 1u << 31;
+    Mut<u32> p = 0;
+    while (true)
+    {
+      if (a & m)
+      {
+        p ^= b;
+        if ((a & (m - 1)) == 0)
+        {
+          break;
+        }
+      }
+      m >>= 1;
+      b = (b & 1) ? (b >> 1) ^ CRC32C_POLY : b >> 1;
+    }
+    return p;
+  }
+
+  // x^n mod P
+  constexpr auto crc32c_xnmodp(Mut<u64> n) -> u32
+  {
+    Mut<u32> result = 1u << 31;
+    Mut<u32> square = 1u << 30; // x^1
+    while (n)
+    {
+      if (n & 1)
+      {
+        result = crc32c_multmodp(square, result);
+      }
+      square = crc32c_multmodp(square, square);
+      n >>= 1;
+    }
+    return result;
+  }
+
+  // Three independent crc32 instruction streams hide the instruction's 3 cycle latency. Each
+  // block's partial CRC is moved forward over the blocks after it with a carry-less multiply by
+  // x^(8 * shift_bytes - 33) (the extra bit compensates for the reflected product being one bit
+  // short), and the 64-bit product is reduced back to 32 bits by one more crc32 instruction.
+  constexpr const usize CRC32_LONG_BLOCK = 8192;
+  constexpr const usize CRC32_SHORT_BLOCK = 256;
+
+  struct Crc32FoldConstants
+  {
+    Mut<u32> long_2x = crc32c_xnmodp(CRC32_LONG_BLOCK * 2 * 8 - 33);
+    Mut<u32> long_1x = crc32c_xnmodp(CRC32_LONG_BLOCK * 8 - 33);
+    Mut<u32> short_2x = crc32c_xnmodp(CRC32_SHORT_BLOCK * 2 * 8 - 33);
+    Mut<u32> short_1x = crc32c_xnmodp(CRC32_SHORT_BLOCK * 8 - 33);
+  };
+
+  static constexpr const Crc32FoldConstants CRC32_FOLD{};
+
 #if IA_ARCH_X64
-  inline auto crc32_x64_hw(Ref<Span<const u8>> data) -> u32
+  // PCLMULQDQ comes with every AVX2 CPU but isn't among IACore's own compile flags
+  __attribute__((target("pclmul,sse4.2"))) inline auto crc32_x64_shift(const u32 crc, const u32 constant) -> u64
   {
-    Mut<const u8 *> p = data.data();
+    const __m128i product = _mm_clmulepi64_si128(_mm_cvtsi32_si128(static_cast<i32>(crc)),
+                                                 _mm_cvtsi32_si128(static_cast<i32>(constant)), 0x00);
+    return static_cast<u64>(_mm_cvtsi128_si64(product));
+  }
+
+  template<usize BlockSize>
+  __attribute__((target("pclmul,sse4.2"))) inline auto crc32_x64_three_way(Mut<u32> crc, MutRef<const u8 *> p,
+                                                                            MutRef<usize> len, const u32 k_2x,
+                                                                            const u32 k_1x) -> u32
+  {
+    while (len >= BlockSize * 3)
+    {
+      Mut<u64> crc_a = crc;
+      Mut<u64> crc_b = 0;
+      Mut<u64> crc_c = 0;
+
+      for (Mut<usize> i = 0; i < BlockSize; i += 8)
+      {
+        crc_a = _mm_crc32_u64(crc_a, read_unaligned<u64>(p + i));
+        crc_b = _mm_crc32_u64(crc_b, read_unaligned<u64>(p + BlockSize + i));
+        crc_c = _mm_crc32_u64(crc_c, read_unaligned<u64>(p + BlockSize * 2 + i));
+      }
+
+      const u64 folded =
+          crc32_x64_shift(static_cast<u32>(crc_a), k_2x) ^ crc32_x64_shift(static_cast<u32>(crc_b), k_1x);
+      crc = static_cast<u32>(_mm_crc32_u64(0, folded)) ^ static_cast<u32>(crc_c);
+
+      p += BlockSize * 3;
+      len -= BlockSize * 3;
+    }
+    return crc;
+  }
 
-    Mut<u32> crc = 0xFFFFFFFF;
+  __attribute__((target("pclmul,sse4.2"))) inline auto crc32_x64_hw(Mut<u32> crc, Ref<Span<const u8>> data) -> u32
+  {
+    Mut<const u8 *> p = data.data();
     Mut<usize> len = data.size();
 
+    crc = crc32_x64_three_way<CRC32_LONG_BLOCK>(crc, p, len, CRC32_FOLD.long_2x, CRC32_FOLD.long_1x);
+    crc = crc32_x64_three_way<CRC32_SHORT_BLOCK>(crc, p, len, CRC32_FOLD.short_2x, CRC32_FOLD.short_1x);
+
     while (len >= 8)
     {
       const u64 chunk = read_unaligned<u64>(p);
@@ -90,18 +190,56 @@ namespace IACore
       crc = _mm_crc32_u8(crc, *p++);
     }
 
-    return ~crc;
+    return crc;
   }
 #endif
 
 #if IA_ARCH_ARM64
-  __attribute__((target("+crc"))) inline auto crc32_arm64_hw(Ref<Span<const u8>> data) -> u32
+  __attribute__((target("+crc+crypto"))) inline auto crc32_arm64_shift(const u32 crc, const u32 constant) -> u64
   {
-    Mut<const u8 *> p = data.data();
+    const poly128_t product = vmull_p64(static_cast<poly64_t>(crc), static_cast<poly64_t>(constant));
+    return vgetq_lane_u64(vreinterpretq_u64_p128(product), 0);
+  }
+
+  template<usize BlockSize>
+  __attribute__((target("+crc+crypto"))) inline auto crc32_arm64_three_way(Mut<u32> crc, MutRef<const u8 *> p,
+                                                                            MutRef<usize> len, const u32 k_2x,
+                                                                            const u32 k_1x) -> u32
+  {
+    while (len >= BlockSize * 3)
+    {
+      Mut<u32> crc_a = crc;
+      Mut<u32> crc_b = 0;
+      Mut<u32> crc_c = 0;
+
+      for (Mut<usize> i = 0; i < BlockSize; i += 8)
+      {
+        crc_a = __crc32cd(crc_a, read_unaligned<u64>(p + i));
+        crc_b = __crc32cd(crc_b, read_unaligned<u64>(p + BlockSize + i));
+        crc_c = __crc32cd(crc_c, read_unaligned<u64>(p + BlockSize * 2 + i));
+      }
+
+      const u64 folded = crc32_arm64_shift(crc_a, k_2x) ^ crc32_arm64_shift(crc_b, k_1x);
+      crc = __crc32cd(0, folded) ^ crc_c;
+
+      p += BlockSize * 3;
+      len -= BlockSize * 3;
+    }
+    return crc;
+  }
 
-    Mut<u32> crc = 0xFFFFFFFF;
+  __attribute__((target("+crc+crypto"))) inline auto crc32_arm64_hw(Mut<u32> crc, Ref<Span<const u8>> data,
+                                                                     const bool use_pmull) -> u32
+  {
+    Mut<const u8 *> p = data.data();
     Mut<usize> len = data.size();
 
+    if (use_pmull)
+    {
+      crc = crc32_arm64_three_way<CRC32_LONG_BLOCK>(crc, p, len, CRC32_FOLD.long_2x, CRC32_FOLD.long_1x);
+      crc = crc32_arm64_three_way<CRC32_SHORT_BLOCK>(crc, p, len, CRC32_FOLD.short_2x, CRC32_FOLD.short_1x);
+    }
+
     while (len >= 8)
     {
       const u64 chunk = read_unaligned<u64>(p);
@@ -115,14 +253,13 @@ namespace IACore
       crc = __crc32cb(crc, *p++);
     }
 
-    return ~crc;
+    return crc;
   }
 #endif
 
-  inline auto crc32_software_slice8(Ref<Span<const u8>> data) -> u32
+  inline auto crc32_software_slice8(Mut<u32> crc, Ref<Span<const u8>> data) -> u32
   {
     Mut<const u8 *> p = data.data();
-    Mut<u32> crc = 0xFFFFFFFF;
     Mut<usize> len = data.size();
 
     while (len >= 8)
@@ -144,21 +281,47 @@ namespace IACore
       crc = (crc >> 8) ^ CRC32_TABLES.table[0][(crc ^ *p++) & 0xFF];
     }
 
-    return ~crc;
+    return crc;
   }
 
   auto DataOps::crc32(Ref<Span<const u8>> data) -> u32
+  {
+    return crc32_update(0, data);
+  }
+
+  auto DataOps::crc32_update(const u32 crc, Ref<Span<const u8>> data) -> u32
   {
 #if IA_ARCH_X64
-    // IACore mandates AVX2 so no need to check
-    return crc32_x64_hw(data);
+    // IACore mandates AVX2 (and with it SSE4.2 and PCLMULQDQ) so no need to check
+    return ~crc32_x64_hw(~crc, data);
 #elif IA_ARCH_ARM64
-    if (Platform::GetCapabilities().HardwareCRC32)
+    Ref<Platform::Capabilities> capabilities = Platform::get_capabilities();
+    if (capabilities.hardware_crc32)
     {
-      return crc32_arm64_hw(data);
+      return ~crc32_arm64_hw(~crc, data, capabilities.hardware_clmul);
     }
 #endif
-    return crc32_software_slice8(data);
+    return ~crc32_software_slice8(~crc, data);
+  }
+
+  auto DataOps::crc32_combine(const u32 crc_a, const u32 crc_b, const u64 length_b) -> u32
+  {
+    return crc32c_multmodp(crc32c_xnmodp(length_b * 8), crc_a) ^ crc_b;
+  }
+
+  auto DataOps::Crc32Hasher::reset() -> void
+  {
+    m_crc = 0;
+  }
+
+  auto DataOps::Crc32Hasher::update(Ref<Span<const u8>> data) -> void
+  {
+    m_crc = crc32_update(m_crc, data);
+  }
+
+  auto DataOps::Crc32Hasher::digest() const -> u32
+  {
+    return m_crc;
   }
 
   constexpr const u32 XXH_PRIME32_1 = 0x9E3779B1U;
@@ -175,6 +338,32 @@ namespace IACore
     return seed;
   }
 
+  // Consumes the < 16 byte tail and finalizes
+  inline auto xxh32_finalize(Mut<u32> h32, Mut<const u8 *> p, const u8 *b_end) -> u32
+  {
+    while (p + 4 <= b_end)
+    {
+      const u32 t = read_unaligned<u32>(p) * XXH_PRIME32_3;
+      h32 += t;
+      h32 = std::rotl(h32, 17) * XXH_PRIME32_4;
+      p += 4;
+    }
+
+    while (p < b_end)
+    {
+      h32 += (*p++) * XXH_PRIME32_5;
+      h32 = std::rotl(h32, 11) * XXH_PRIME32_1;
+    }
+
+    h32 ^= h32 >> 15;
+    h32 *= XXH_PRIME32_2;
+    h32 ^= h32 >> 13;
+    h32 *= XXH_PRIME32_3;
+    h32 ^= h32 >> 16;
+
+    return h32;
+  }
+
   auto DataOps::hash_xxhash(Ref<String> string, const u32 seed) -> u32
   {
     return hash_xxhash(Span<const u8>(reinterpret_cast<const u8 *>(string.data()), string.length()), seed);
@@ -216,277 +405,2647 @@ namespace IACore
 
     h32 += static_cast<u32>(data.size());
 
-    while (p + 4 <= b_end)
+    return xxh32_finalize(h32, p, b_end);
+  }
+
+  DataOps::XxhashHasher::XxhashHasher(const u32 seed)
+  {
+    reset(seed);
+  }
+
+  auto DataOps::XxhashHasher::reset(const u32 seed) -> void
+  {
+    m_seed = seed;
+    m_total_length = 0;
+    m_lanes = {seed + XXH_PRIME32_1 + XXH_PRIME32_2, seed + XXH_PRIME32_2, seed, seed - XXH_PRIME32_1};
+    m_buffered = 0;
+  }
+
+  auto DataOps::XxhashHasher::update(Ref<Span<const u8>> data) -> void
+  {
+    Mut<const u8 *> p = data.data();
+    const u8 *b_end = p + data.size();
+    m_total_length += data.size();
+
+    if (m_buffered + data.size() < m_buffer.size())
     {
-      const u32 t = read_unaligned<u32>(p) * XXH_PRIME32_3;
-      h32 += t;
-      h32 = std::rotl(h32, 17) * XXH_PRIME32_4;
-      p += 4;
+      if (!data.empty())
+      {
+        std::memcpy(m_buffer.data() + m_buffered, p, data.size());
+      }
+      m_buffered += data.size();
+      return;
     }
 
-    while (p < b_end)
+    if (m_buffered > 0)
     {
-      h32 += (*p++) * XXH_PRIME32_5;
-      h32 = std::rotl(h32, 11) * XXH_PRIME32_1;
+      const usize fill = m_buffer.size() - m_buffered;
+      std::memcpy(m_buffer.data() + m_buffered, p, fill);
+      p += fill;
+      for (Mut<usize> i = 0; i < 4; ++i)
+      {
+        m_lanes[i] = xxh32_round(m_lanes[i], read_unaligned<u32>(m_buffer.data() + 4 * i));
+      }
+      m_buffered = 0;
     }
 
-    h32 ^= h32 >> 15;
-    h32 *= XXH_PRIME32_2;
-    h32 ^= h32 >> 13;
-    h32 *= XXH_PRIME32_3;
-    h32 ^= h32 >> 16;
+    while (p + 16 <= b_end)
+    {
+      for (Mut<usize> i = 0; i < 4; ++i)
+      {
+        m_lanes[i] = xxh32_round(m_lanes[i], read_unaligned<u32>(p + 4 * i));
+      }
+      p += 16;
+    }
 
-    return h32;
+    m_buffered = static_cast<usize>(b_end - p);
+    if (m_buffered > 0)
+    {
+      std::memcpy(m_buffer.data(), p, m_buffered);
+    }
   }
 
-  constexpr const u32 FNV1A_32_PRIME = 0x01000193;
-  constexpr const u32 FNV1A_32_OFFSET = 0x811c9dc5;
-
-  auto DataOps::hash_fnv1a(Ref<String> string) -> u32
+  auto DataOps::XxhashHasher::digest() const -> u32
   {
-    Mut<u32> hash = FNV1A_32_OFFSET;
-    for (const char c : string)
+    Mut<u32> h32{};
+    if (m_total_length >= 16)
     {
-      hash ^= static_cast<u8>(c);
-      hash *= FNV1A_32_PRIME;
+      h32 = std::rotl(m_lanes[0], 1) + std::rotl(m_lanes[1], 7) + std::rotl(m_lanes[2], 12) +
+            std::rotl(m_lanes[3], 18);
     }
-    return hash;
+    else
+    {
+      h32 = m_seed + XXH_PRIME32_5;
+    }
+
+    h32 += static_cast<u32>(m_total_length);
+
+    return xxh32_finalize(h32, m_buffer.data(), m_buffer.data() + m_buffered);
   }
 
-  auto DataOps::hash_fnv1a(Ref<Span<const u8>> data) -> u32
+  constexpr const u64 XXH_PRIME64_1 = 0x9E3779B185EBCA87ULL;
+  constexpr const u64 XXH_PRIME64_2 = 0xC2B2AE3D27D4EB4FULL;
+  constexpr const u64 XXH_PRIME64_3 = 0x165667B19E3779F9ULL;
+  constexpr const u64 XXH_PRIME64_4 = 0x85EBCA77C2B2AE63ULL;
+  constexpr const u64 XXH_PRIME64_5 = 0x27D4EB2F165667C5ULL;
+
+  inline auto xxh64_round(Mut<u64> acc, const u64 input) -> u64
   {
-    Mut<u32> hash = FNV1A_32_OFFSET;
-    const u8 *ptr = data.data();
+    acc += input * XXH_PRIME64_2;
+    acc = std::rotl(acc, 31);
+    acc *= XXH_PRIME64_1;
+    return acc;
+  }
 
-    for (Mut<usize> i = 0; i < data.size(); ++i)
-    {
-      hash ^= ptr[i];
-      hash *= FNV1A_32_PRIME;
-    }
-    return hash;
+  inline auto xxh64_merge_round(Mut<u64> acc, const u64 value) -> u64
+  {
+    acc ^= xxh64_round(0, value);
+    return acc * XXH_PRIME64_1 + XXH_PRIME64_4;
   }
 
-  auto DataOps::detect_compression(const Span<const u8> data) -> CompressionType
+  inline auto xxh64_avalanche(Mut<u64> h64) -> u64
   {
-    if (data.size() < 2)
+    h64 ^= h64 >> 33;
+    h64 *= XXH_PRIME64_2;
+    h64 ^= h64 >> 29;
+    h64 *= XXH_PRIME64_3;
+    h64 ^= h64 >> 32;
+    return h64;
+  }
+
+  inline auto xxh64_merge_lanes(const u64 v1, const u64 v2, const u64 v3, const u64 v4) -> u64
+  {
+    Mut<u64> h64 = std::rotl(v1, 1) + std::rotl(v2, 7) + std::rotl(v3, 12) + std::rotl(v4, 18);
+    h64 = xxh64_merge_round(h64, v1);
+    h64 = xxh64_merge_round(h64, v2);
+    h64 = xxh64_merge_round(h64, v3);
+    h64 = xxh64_merge_round(h64, v4);
+    return h64;
+  }
+
+  // Consumes the < 32 byte tail and finalizes
+  inline auto xxh64_finalize(Mut<u64> h64, Mut<const u8 *> p, Mut<usize> len) -> u64
+  {
+    while (len >= 8)
     {
-      return CompressionType::None;
+      h64 ^= xxh64_round(0, read_unaligned<u64>(p));
+      h64 = std::rotl(h64, 27) * XXH_PRIME64_1 + XXH_PRIME64_4;
+      p += 8;
+      len -= 8;
     }
 
-    if (data[0] == 0x1F && data[1] == 0x8B)
+    if (len >= 4)
     {
-      return CompressionType::Gzip;
+      h64 ^= static_cast<u64>(read_unaligned<u32>(p)) * XXH_PRIME64_1;
+      h64 = std::rotl(h64, 23) * XXH_PRIME64_2 + XXH_PRIME64_3;
+      p += 4;
+      len -= 4;
     }
 
-    if (data[0] == 0x78 && (data[1] == 0x01 || data[1] == 0x9C || data[1] == 0xDA))
+    while (len--)
     {
-      return CompressionType::Zlib;
+      h64 ^= (*p++) * XXH_PRIME64_5;
+      h64 = std::rotl(h64, 11) * XXH_PRIME64_1;
     }
 
-    return CompressionType::None;
+    return xxh64_avalanche(h64);
   }
 
-  auto DataOps::zlib_inflate(Ref<Span<const u8>> data) -> Result<Vec<u8>>
+  auto DataOps::hash_xxhash64(Ref<String> string, const u64 seed) -> u64
   {
-    Mut<z_stream> zs{};
-    zs.zalloc = Z_NULL;
-    zs.zfree = Z_NULL;
-    zs.opaque = Z_NULL;
+    return hash_xxhash64(Span<const u8>(reinterpret_cast<const u8 *>(string.data()), string.length()), seed);
+  }
+
+  auto DataOps::hash_xxhash64(Ref<Span<const u8>> data, const u64 seed) -> u64
+  {
+    Mut<const u8 *> p = data.data();
+    Mut<usize> len = data.size();
+    Mut<u64> h64{};
+
+    if (len >= 32)
+    {
+      Mut<u64> v1 = seed + XXH_PRIME64_1 + XXH_PRIME64_2;
+      Mut<u64> v2 = seed + XXH_PRIME64_2;
+      Mut<u64> v3 = seed + 0;
+      Mut<u64> v4 = seed - XXH_PRIME64_1;
 
-    if (inflateInit2(&zs, 15 + 32) != Z_OK)
+      do
+      {
+        v1 = xxh64_round(v1, read_unaligned<u64>(p));
+        v2 = xxh64_round(v2, read_unaligned<u64>(p + 8));
+        v3 = xxh64_round(v3, read_unaligned<u64>(p + 16));
+        v4 = xxh64_round(v4, read_unaligned<u64>(p + 24));
+        p += 32;
+        len -= 32;
+      } while (len >= 32);
+
+      h64 = xxh64_merge_lanes(v1, v2, v3, v4);
+    }
+    else
     {
-      return fail("Failed to initialize zlib inflate");
+      h64 = seed + XXH_PRIME64_5;
     }
 
-    zs.next_in = const_cast<Bytef *>(data.data());
-    zs.avail_in = static_cast<uInt>(data.size());
+    h64 += static_cast<u64>(data.size());
 
-    Mut<Vec<u8>> out_buffer;
-    const usize guess_size = data.size() < 1024 ? data.size() * 4 : data.size() * 2;
-    out_buffer.resize(guess_size);
+    return xxh64_finalize(h64, p, len);
+  }
 
-    zs.next_out = reinterpret_cast<Bytef *>(out_buffer.data());
-    zs.avail_out = static_cast<uInt>(out_buffer.size());
+  DataOps::Xxhash64Hasher::Xxhash64Hasher(const u64 seed)
+  {
+    reset(seed);
+  }
 
-    Mut<int> ret;
-    do
+  auto DataOps::Xxhash64Hasher::reset(const u64 seed) -> void
+  {
+    m_seed = seed;
+    m_total_length = 0;
+    m_lanes = {seed + XXH_PRIME64_1 + XXH_PRIME64_2, seed + XXH_PRIME64_2, seed, seed - XXH_PRIME64_1};
+    m_buffered = 0;
+  }
+
+  auto DataOps::Xxhash64Hasher::update(Ref<Span<const u8>> data) -> void
+  {
+    Mut<const u8 *> p = data.data();
+    const u8 *b_end = p + data.size();
+    m_total_length += data.size();
+
+    if (m_buffered + data.size() < m_buffer.size())
     {
-      if (zs.avail_out == 0)
+      if (!data.empty())
       {
-        const usize current_pos = zs.total_out;
-        const usize new_size = out_buffer.size() * 2;
-        out_buffer.resize(new_size);
-
-        zs.next_out = reinterpret_cast<Bytef *>(out_buffer.data() + current_pos);
-        zs.avail_out = static_cast<uInt>(new_size - current_pos);
+        std::memcpy(m_buffer.data() + m_buffered, p, data.size());
       }
+      m_buffered += data.size();
+      return;
+    }
 
-      ret = inflate(&zs, Z_NO_FLUSH);
-
-    } while (ret == Z_OK);
-
-    inflateEnd(&zs);
-
-    if (ret != Z_STREAM_END)
+    if (m_buffered > 0)
     {
-      return fail("Failed to inflate: corrupt data or stream error");
+      const usize fill = m_buffer.size() - m_buffered;
+      std::memcpy(m_buffer.data() + m_buffered, p, fill);
+      p += fill;
+      for (Mut<usize> i = 0; i < 4; ++i)
+      {
+        m_lanes[i] = xxh64_round(m_lanes[i], read_unaligned<u64>(m_buffer.data() + 8 * i));
+      }
+      m_buffered = 0;
     }
 
-    out_buffer.resize(zs.total_out);
+    while (p + 32 <= b_end)
+    {
+      for (Mut<usize> i = 0; i < 4; ++i)
+      {
+        m_lanes[i] = xxh64_round(m_lanes[i], read_unaligned<u64>(p + 8 * i));
+      }
+      p += 32;
+    }
 
-    return out_buffer;
+    m_buffered = static_cast<usize>(b_end - p);
+    if (m_buffered > 0)
+    {
+      std::memcpy(m_buffer.data(), p, m_buffered);
+    }
   }
 
-  auto DataOps::zlib_deflate(Ref<Span<const u8>> data) -> Result<Vec<u8>>
+  auto DataOps::Xxhash64Hasher::digest() const -> u64
   {
-    Mut<z_stream> zs{};
-    zs.zalloc = Z_NULL;
-    zs.zfree = Z_NULL;
-    zs.opaque = Z_NULL;
+    Mut<u64> h64 = m_total_length >= 32 ? xxh64_merge_lanes(m_lanes[0], m_lanes[1], m_lanes[2], m_lanes[3])
+                                        : m_seed + XXH_PRIME64_5;
+    h64 += m_total_length;
 
-    if (deflateInit(&zs, Z_DEFAULT_COMPRESSION) != Z_OK)
-    {
-      return fail("Failed to initialize zlib deflate");
-    }
+    return xxh64_finalize(h64, m_buffer.data(), m_buffered);
+  }
 
-    zs.next_in = const_cast<Bytef *>(data.data());
-    zs.avail_in = static_cast<uInt>(data.size());
+  // XXH3 (XXH3_64bits / XXH3_128bits from xxHash 0.8, bit-exact). Inputs up to 240 bytes take
+  // dedicated short paths; longer inputs run 64 byte stripes through eight 64-bit accumulators.
+
+  constexpr const usize XXH3_SECRET_SIZE = 192;
+  constexpr const usize XXH3_SECRET_SIZE_MIN = 136;
+  constexpr const usize XXH3_STRIPE_LEN = 64;
+  constexpr const usize XXH3_SECRET_CONSUME_RATE = 8;
+  constexpr const usize XXH3_ACC_COUNT = 8;
+  constexpr const usize XXH3_MIDSIZE_MAX = 240;
+  constexpr const usize XXH3_MIDSIZE_STARTOFFSET = 3;
+  constexpr const usize XXH3_MIDSIZE_LASTOFFSET = 17;
+  constexpr const usize XXH3_SECRET_LASTACC_START = 7;
+  constexpr const usize XXH3_SECRET_MERGEACCS_START = 11;
+  constexpr const usize XXH3_STRIPES_PER_BLOCK = (XXH3_SECRET_SIZE - XXH3_STRIPE_LEN) / XXH3_SECRET_CONSUME_RATE;
+
+  constexpr const u64 XXH3_PRIME_MX1 = 0x165667919E3779F9ULL;
+  constexpr const u64 XXH3_PRIME_MX2 = 0x9FB21C651E98DF25ULL;
+
+  alignas(64) constexpr const u8 XXH3_DEFAULT_SECRET[XXH3_SECRET_SIZE] = {
+      0xb8, 0xfe, 0x6c, 0x39, 0x23, 0xa4, 0x4b, 0xbe, 0x7c, 0x01, 0x81, 0x2c, 0xf7, 0x21, 0xad, 0x1c, 0xde, 0xd4, 0x6d,
+      0xe9, 0x83, 0x90, 0x97, 0xdb, 0x72, 0x40, 0xa4, 0xa4, 0xb7, 0xb3, 0x67, 0x1f, 0xcb, 0x79, 0xe6, 0x4e, 0xcc, 0xc0,
+      0xe5, 0x78, 0x82, 0x5a, 0xd0, 0x7d, 0xcc, 0xff, 0x72, 0x21, 0xb8, 0x08, 0x46, 0x74, 0xf7, 0x43, 0x24, 0x8e, 0xe0,
+      0x35, 0x90, 0xe6, 0x81, 0x3a, 0x26, 0x4c, 0x3c, 0x28, 0x52, 0xbb, 0x91, 0xc3, 0x00, 0xcb, 0x88, 0xd0, 0x65, 0x8b,
+      0x1b, 0x53, 0x2e, 0xa3, 0x71, 0x64, 0x48, 0x97, 0xa2, 0x0d, 0xf9, 0x4e, 0x38, 0x19, 0xef, 0x46, 0xa9, 0xde, 0xac,
+      0xd8, 0xa8, 0xfa, 0x76, 0x3f, 0xe3, 0x9c, 0x34, 0x3f, 0xf9, 0xdc, 0xbb, 0xc7, 0xc7, 0x0b, 0x4f, 0x1d, 0x8a, 0x51,
+      0xe0, 0x4b, 0xcd, 0xb4, 0x59, 0x31, 0xc8, 0x9f, 0x7e, 0xc9, 0xd9, 0x78, 0x73, 0x64, 0xea, 0xc5, 0xac, 0x83, 0x34,
+      0xd3, 0xeb, 0xc3, 0xc5, 0x81, 0xa0, 0xff, 0xfa, 0x13, 0x63, 0xeb, 0x17, 0x0d, 0xdd, 0x51, 0xb7, 0xf0, 0xda, 0x49,
+      0xd3, 0x16, 0x55, 0x26, 0x29, 0xd4, 0x68, 0x9e, 0x2b, 0x16, 0xbe, 0x58, 0x7d, 0x47, 0xa1, 0xfc, 0x8f, 0xf8, 0xb8,
+      0xd1, 0x7a, 0xd0, 0x31, 0xce, 0x45, 0xcb, 0x3a, 0x8f, 0x95, 0x16, 0x04, 0x28, 0xaf, 0xd7, 0xfb, 0xca, 0xbb, 0x4b,
+      0x40, 0x7e,
+  };
 
-    Mut<Vec<u8>> out_buffer;
-    out_buffer.resize(deflateBound(&zs, static_cast<uLong>(data.size())));
+  using Xxh3Accumulators = Array<u64, XXH3_ACC_COUNT>;
 
-    zs.next_out = reinterpret_cast<Bytef *>(out_buffer.data());
-    zs.avail_out = static_cast<uInt>(out_buffer.size());
+  constexpr const Xxh3Accumulators XXH3_INIT_ACC = {XXH_PRIME32_3, XXH_PRIME64_1, XXH_PRIME64_2, XXH_PRIME64_3,
+                                                     XXH_PRIME64_4, XXH_PRIME32_2, XXH_PRIME64_5, XXH_PRIME32_1};
 
-    const int ret = deflate(&zs, Z_FINISH);
+  inline auto xxh3_mul128_fold64(const u64 lhs, const u64 rhs) -> u64
+  {
+#if defined(__SIZEOF_INT128__)
+    const unsigned __int128 product = static_cast<unsigned __int128>(lhs) * rhs;
+    return static_cast<u64>(product) ^ static_cast<u64>(product >> 64);
+#elif IA_ARCH_X64 && defined(_MSC_VER)
+    Mut<u64> high = 0;
+    const u64 low = _umul128(lhs, rhs, &high);
+    return low ^ high;
+#else
+    const u64 lo_lo = (lhs & 0xFFFFFFFF) * (rhs & 0xFFFFFFFF);
+    const u64 hi_lo = (lhs >> 32) * (rhs & 0xFFFFFFFF);
+    const u64 lo_hi = (lhs & 0xFFFFFFFF) * (rhs >> 32);
+    const u64 hi_hi = (lhs >> 32) * (rhs >> 32);
+    const u64 cross = (lo_lo >> 32) + (hi_lo & 0xFFFFFFFF) + lo_hi;
+    const u64 upper = (hi_lo >> 32) + (cross >> 32) + hi_hi;
+    const u64 lower = (cross << 32) | (lo_lo & 0xFFFFFFFF);
+    return lower ^ upper;
+#endif
+  }
 
-    if (ret != Z_STREAM_END)
-    {
-      deflateEnd(&zs);
-      return fail("Failed to deflate, ran out of buffer memory");
-    }
+  inline auto xxh3_mul128(const u64 lhs, const u64 rhs) -> DataOps::Hash128
+  {
+#if defined(__SIZEOF_INT128__)
+    const unsigned __int128 product = static_cast<unsigned __int128>(lhs) * rhs;
+    return {static_cast<u64>(product), static_cast<u64>(product >> 64)};
+#elif IA_ARCH_X64 && defined(_MSC_VER)
+    Mut<u64> high = 0;
+    const u64 low = _umul128(lhs, rhs, &high);
+    return {low, high};
+#else
+    const u64 lo_lo = (lhs & 0xFFFFFFFF) * (rhs & 0xFFFFFFFF);
+    const u64 hi_lo = (lhs >> 32) * (rhs & 0xFFFFFFFF);
+    const u64 lo_hi = (lhs & 0xFFFFFFFF) * (rhs >> 32);
+    const u64 hi_hi = (lhs >> 32) * (rhs >> 32);
+    const u64 cross = (lo_lo >> 32) + (hi_lo & 0xFFFFFFFF) + lo_hi;
+    return {(cross << 32) | (lo_lo & 0xFFFFFFFF), (hi_lo >> 32) + (cross >> 32) + hi_hi};
+#endif
+  }
 
-    out_buffer.resize(zs.total_out);
+  inline auto xxh3_avalanche(Mut<u64> h64) -> u64
+  {
+    h64 ^= h64 >> 37;
+    h64 *= XXH3_PRIME_MX1;
+    h64 ^= h64 >> 32;
+    return h64;
+  }
 
-    deflateEnd(&zs);
-    return out_buffer;
+  inline auto xxh3_rrmxmx(Mut<u64> h64, const u64 len) -> u64
+  {
+    h64 ^= std::rotl(h64, 49) ^ std::rotl(h64, 24);
+    h64 *= XXH3_PRIME_MX2;
+    h64 ^= (h64 >> 35) + len;
+    h64 *= XXH3_PRIME_MX2;
+    return h64 ^ (h64 >> 28);
   }
 
-  auto DataOps::zstd_inflate(Ref<Span<const u8>> data) -> Result<Vec<u8>>
+  inline auto xxh3_mix16(const u8 *input, const u8 *secret, const u64 seed) -> u64
   {
-    const unsigned long long content_size = ZSTD_getFrameContentSize(data.data(), data.size());
+    return xxh3_mul128_fold64(read_unaligned<u64>(input) ^ (read_unaligned<u64>(secret) + seed),
+                              read_unaligned<u64>(input + 8) ^ (read_unaligned<u64>(secret + 8) - seed));
+  }
 
-    if (content_size == ZSTD_CONTENTSIZE_ERROR)
+  inline auto xxh3_len_0to16_64(const u8 *input, const usize len, const u8 *secret, Mut<u64> seed) -> u64
+  {
+    if (len > 8)
     {
-      return fail("Failed to inflate: Not valid ZSTD compressed data");
+      const u64 bitflip1 = (read_unaligned<u64>(secret + 24) ^ read_unaligned<u64>(secret + 32)) + seed;
+      const u64 bitflip2 = (read_unaligned<u64>(secret + 40) ^ read_unaligned<u64>(secret + 48)) - seed;
+      const u64 input_lo = read_unaligned<u64>(input) ^ bitflip1;
+      const u64 input_hi = read_unaligned<u64>(input + len - 8) ^ bitflip2;
+      const u64 acc = len + std::byteswap(input_lo) + input_hi + xxh3_mul128_fold64(input_lo, input_hi);
+      return xxh3_avalanche(acc);
     }
 
-    if (content_size != ZSTD_CONTENTSIZE_UNKNOWN)
+    if (len >= 4)
     {
-      Mut<Vec<u8>> out_buffer;
-      out_buffer.resize(static_cast<usize>(content_size));
+      seed ^= static_cast<u64>(std::byteswap(static_cast<u32>(seed))) << 32;
+      const u32 input1 = read_unaligned<u32>(input);
+      const u32 input2 = read_unaligned<u32>(input + len - 4);
+      const u64 bitflip = (read_unaligned<u64>(secret + 8) ^ read_unaligned<u64>(secret + 16)) - seed;
+      const u64 input64 = input2 + (static_cast<u64>(input1) << 32);
+      return xxh3_rrmxmx(input64 ^ bitflip, len);
+    }
 
-      const usize d_size = ZSTD_decompress(out_buffer.data(), out_buffer.size(), data.data(), data.size());
+    if (len > 0)
+    {
+      const u32 combined = (static_cast<u32>(input[0]) << 16) | (static_cast<u32>(input[len >> 1]) << 24) |
+                           static_cast<u32>(input[len - 1]) | (static_cast<u32>(len) << 8);
+      const u64 bitflip = (read_unaligned<u32>(secret) ^ read_unaligned<u32>(secret + 4)) + seed;
+      return xxh64_avalanche(static_cast<u64>(combined) ^ bitflip);
+    }
 
-      if (ZSTD_isError(d_size))
-      {
+    return xxh64_avalanche(seed ^ (read_unaligned<u64>(secret + 56) ^ read_unaligned<u64>(secret + 64)));
+  }
+
+  inline auto xxh3_len_17to128_64(const u8 *input, const usize len, const u8 *secret, const u64 seed) -> u64
+  {
+    Mut<u64> acc = len * XXH_PRIME64_1;
+    if (len > 32)
+    {
+      if (len > 64)
+      {
+        if (len > 96)
+        {
+          acc += xxh3_mix16(input + 48, secret + 96, seed);
+          acc += xxh3_mix16(input + len - 64, secret + 112, seed);
+        }
+        acc += xxh3_mix16(input + 32, secret + 64, seed);
+        acc += xxh3_mix16(input + len - 48, secret + 80, seed);
+      }
+      acc += xxh3_mix16(input + 16, secret + 32, seed);
+      acc += xxh3_mix16(input + len - 32, secret + 48, seed);
+    }
+    acc += xxh3_mix16(input, secret, seed);
+    acc += xxh3_mix16(input + len - 16, secret + 16, seed);
+    return xxh3_avalanche(acc);
+  }
+
+  inline auto xxh3_len_129to240_64(const u8 *input, const usize len, const u8 *secret, const u64 seed) -> u64
+  {
+    Mut<u64> acc = len * XXH_PRIME64_1;
+    const usize rounds = len / 16;
+
+    for (Mut<usize> i = 0; i < 8; ++i)
+    {
+      acc += xxh3_mix16(input + 16 * i, secret + 16 * i, seed);
+    }
+    Mut<u64> acc_end = xxh3_mix16(input + len - 16, secret + XXH3_SECRET_SIZE_MIN - XXH3_MIDSIZE_LASTOFFSET, seed);
+    acc = xxh3_avalanche(acc);
+
+    for (Mut<usize> i = 8; i < rounds; ++i)
+    {
+      acc_end += xxh3_mix16(input + 16 * i, secret + 16 * (i - 8) + XXH3_MIDSIZE_STARTOFFSET, seed);
+    }
+    return xxh3_avalanche(acc + acc_end);
+  }
+
+  inline auto xxh3_mix32_128(Mut<DataOps::Hash128> acc, const u8 *input_1, const u8 *input_2, const u8 *secret,
+                             const u64 seed) -> DataOps::Hash128
+  {
+    acc.low += xxh3_mix16(input_1, secret, seed);
+    acc.low ^= read_unaligned<u64>(input_2) + read_unaligned<u64>(input_2 + 8);
+    acc.high += xxh3_mix16(input_2, secret + 16, seed);
+    acc.high ^= read_unaligned<u64>(input_1) + read_unaligned<u64>(input_1 + 8);
+    return acc;
+  }
+
+  inline auto xxh3_finalize_mid_128(Ref<DataOps::Hash128> acc, const usize len, const u64 seed) -> DataOps::Hash128
+  {
+    const u64 low = acc.low + acc.high;
+    const u64 high = (acc.low * XXH_PRIME64_1) + (acc.high * XXH_PRIME64_4) + ((len - seed) * XXH_PRIME64_2);
+    return {xxh3_avalanche(low), 0 - xxh3_avalanche(high)};
+  }
+
+  inline auto xxh3_len_0to16_128(const u8 *input, const usize len, const u8 *secret, Mut<u64> seed)
+      -> DataOps::Hash128
+  {
+    if (len > 8)
+    {
+      const u64 bitflipl = (read_unaligned<u64>(secret + 32) ^ read_unaligned<u64>(secret + 40)) - seed;
+      const u64 bitfliph = (read_unaligned<u64>(secret + 48) ^ read_unaligned<u64>(secret + 56)) + seed;
+      const u64 input_lo = read_unaligned<u64>(input);
+      Mut<u64> input_hi = read_unaligned<u64>(input + len - 8);
+
+      Mut<DataOps::Hash128> m128 = xxh3_mul128(input_lo ^ input_hi ^ bitflipl, XXH_PRIME64_1);
+      m128.low += static_cast<u64>(len - 1) << 54;
+      input_hi ^= bitfliph;
+      m128.high += input_hi + static_cast<u64>(static_cast<u32>(input_hi)) * (XXH_PRIME32_2 - 1);
+      m128.low ^= std::byteswap(m128.high);
+
+      Mut<DataOps::Hash128> h128 = xxh3_mul128(m128.low, XXH_PRIME64_2);
+      h128.high += m128.high * XXH_PRIME64_2;
+      return {xxh3_avalanche(h128.low), xxh3_avalanche(h128.high)};
+    }
+
+    if (len >= 4)
+    {
+      seed ^= static_cast<u64>(std::byteswap(static_cast<u32>(seed))) << 32;
+      const u32 input_lo = read_unaligned<u32>(input);
+      const u32 input_hi = read_unaligned<u32>(input + len - 4);
+      const u64 input_64 = input_lo + (static_cast<u64>(input_hi) << 32);
+      const u64 bitflip = (read_unaligned<u64>(secret + 16) ^ read_unaligned<u64>(secret + 24)) + seed;
+
+      Mut<DataOps::Hash128> m128 = xxh3_mul128(input_64 ^ bitflip, XXH_PRIME64_1 + (len << 2));
+      m128.high += m128.low << 1;
+      m128.low ^= m128.high >> 3;
+      m128.low ^= m128.low >> 35;
+      m128.low *= XXH3_PRIME_MX2;
+      m128.low ^= m128.low >> 28;
+      m128.high = xxh3_avalanche(m128.high);
+      return m128;
+    }
+
+    if (len > 0)
+    {
+      const u32 combined_lo = (static_cast<u32>(input[0]) << 16) | (static_cast<u32>(input[len >> 1]) << 24) |
+                              static_cast<u32>(input[len - 1]) | (static_cast<u32>(len) << 8);
+      const u32 combined_hi = std::rotl(std::byteswap(combined_lo), 13);
+      const u64 bitflipl = (read_unaligned<u32>(secret) ^ read_unaligned<u32>(secret + 4)) + seed;
+      const u64 bitfliph = (read_unaligned<u32>(secret + 8) ^ read_unaligned<u32>(secret + 12)) - seed;
+      return {xxh64_avalanche(static_cast<u64>(combined_lo) ^ bitflipl),
+              xxh64_avalanche(static_cast<u64>(combined_hi) ^ bitfliph)};
+    }
+
+    return {xxh64_avalanche(seed ^ (read_unaligned<u64>(secret + 64) ^ read_unaligned<u64>(secret + 72))),
+            xxh64_avalanche(seed ^ (read_unaligned<u64>(secret + 80) ^ read_unaligned<u64>(secret + 88)))};
+  }
+
+  inline auto xxh3_len_17to128_128(const u8 *input, const usize len, const u8 *secret, const u64 seed)
+      -> DataOps::Hash128
+  {
+    Mut<DataOps::Hash128> acc{len * XXH_PRIME64_1, 0};
+    if (len > 32)
+    {
+      if (len > 64)
+      {
+        if (len > 96)
+        {
+          acc = xxh3_mix32_128(acc, input + 48, input + len - 64, secret + 96, seed);
+        }
+        acc = xxh3_mix32_128(acc, input + 32, input + len - 48, secret + 64, seed);
+      }
+      acc = xxh3_mix32_128(acc, input + 16, input + len - 32, secret + 32, seed);
+    }
+    acc = xxh3_mix32_128(acc, input, input + len - 16, secret, seed);
+    return xxh3_finalize_mid_128(acc, len, seed);
+  }
+
+  inline auto xxh3_len_129to240_128(const u8 *input, const usize len, const u8 *secret, const u64 seed)
+      -> DataOps::Hash128
+  {
+    Mut<DataOps::Hash128> acc{len * XXH_PRIME64_1, 0};
+
+    for (Mut<usize> i = 32; i < 160; i += 32)
+    {
+      acc = xxh3_mix32_128(acc, input + i - 32, input + i - 16, secret + i - 32, seed);
+    }
+    acc.low = xxh3_avalanche(acc.low);
+    acc.high = xxh3_avalanche(acc.high);
+
+    for (Mut<usize> i = 160; i <= len; i += 32)
+    {
+      acc = xxh3_mix32_128(acc, input + i - 32, input + i - 16, secret + XXH3_MIDSIZE_STARTOFFSET + i - 160, seed);
+    }
+    acc = xxh3_mix32_128(acc, input + len - 16, input + len - 32,
+                         secret + XXH3_SECRET_SIZE_MIN - XXH3_MIDSIZE_LASTOFFSET - 16, 0 - seed);
+    return xxh3_finalize_mid_128(acc, len, seed);
+  }
+
+#if IA_ARCH_X64
+  inline auto xxh3_accumulate_avx2(const __m256i acc, const u8 *data, const u8 *key) -> __m256i
+  {
+    const __m256i data_vec = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(data));
+    const __m256i key_vec = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(key));
+    const __m256i data_key = _mm256_xor_si256(data_vec, key_vec);
+    const __m256i product = _mm256_mul_epu32(data_key, _mm256_srli_epi64(data_key, 32));
+    const __m256i data_swap = _mm256_shuffle_epi32(data_vec, _MM_SHUFFLE(1, 0, 3, 2));
+    return _mm256_add_epi64(product, _mm256_add_epi64(acc, data_swap));
+  }
+#endif
+
+  // Runs `stripes` 64 byte stripes through the accumulators, advancing the secret 8 bytes per stripe
+  inline auto xxh3_accumulate(MutRef<Xxh3Accumulators> acc, const u8 *input, const u8 *secret, const usize stripes)
+      -> void
+  {
+#if IA_ARCH_X64
+    __m256i acc_0 = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(acc.data()));
+    __m256i acc_1 = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(acc.data() + 4));
+
+    for (Mut<usize> n = 0; n < stripes; ++n)
+    {
+      const u8 *data = input + n * XXH3_STRIPE_LEN;
+      const u8 *key = secret + n * XXH3_SECRET_CONSUME_RATE;
+      acc_0 = xxh3_accumulate_avx2(acc_0, data, key);
+      acc_1 = xxh3_accumulate_avx2(acc_1, data + 32, key + 32);
+    }
+
+    _mm256_storeu_si256(reinterpret_cast<__m256i *>(acc.data()), acc_0);
+    _mm256_storeu_si256(reinterpret_cast<__m256i *>(acc.data() + 4), acc_1);
+#elif IA_ARCH_ARM64
+    uint64x2_t lanes[4];
+    for (Mut<usize> i = 0; i < 4; ++i)
+    {
+      lanes[i] = vld1q_u64(acc.data() + 2 * i);
+    }
+
+    for (Mut<usize> n = 0; n < stripes; ++n)
+    {
+      const u8 *data = input + n * XXH3_STRIPE_LEN;
+      const u8 *key = secret + n * XXH3_SECRET_CONSUME_RATE;
+      for (Mut<usize> i = 0; i < 4; ++i)
+      {
+        const uint64x2_t data_vec = vreinterpretq_u64_u8(vld1q_u8(data + 16 * i));
+        const uint64x2_t key_vec = vreinterpretq_u64_u8(vld1q_u8(key + 16 * i));
+        const uint64x2_t data_key = veorq_u64(data_vec, key_vec);
+        lanes[i] = vaddq_u64(lanes[i], vextq_u64(data_vec, data_vec, 1));
+        lanes[i] = vmlal_u32(lanes[i], vmovn_u64(data_key), vshrn_n_u64(data_key, 32));
+      }
+    }
+
+    for (Mut<usize> i = 0; i < 4; ++i)
+    {
+      vst1q_u64(acc.data() + 2 * i, lanes[i]);
+    }
+#else
+    for (Mut<usize> n = 0; n < stripes; ++n)
+    {
+      const u8 *data = input + n * XXH3_STRIPE_LEN;
+      const u8 *key = secret + n * XXH3_SECRET_CONSUME_RATE;
+      for (Mut<usize> i = 0; i < XXH3_ACC_COUNT; ++i)
+      {
+        const u64 data_val = read_unaligned<u64>(data + 8 * i);
+        const u64 data_key = data_val ^ read_unaligned<u64>(key + 8 * i);
+        acc[i ^ 1] += data_val;
+        acc[i] += (data_key & 0xFFFFFFFF) * (data_key >> 32);
+      }
+    }
+#endif
+  }
+
+  inline auto xxh3_scramble(MutRef<Xxh3Accumulators> acc, const u8 *secret) -> void
+  {
+#if IA_ARCH_X64
+    const __m256i prime32 = _mm256_set1_epi32(static_cast<i32>(XXH_PRIME32_1));
+    for (Mut<usize> i = 0; i < 2; ++i)
+    {
+      const __m256i acc_vec = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(acc.data() + 4 * i));
+      const __m256i key_vec = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(secret + 32 * i));
+      const __m256i data_key =
+          _mm256_xor_si256(_mm256_xor_si256(acc_vec, _mm256_srli_epi64(acc_vec, 47)), key_vec);
+      const __m256i product_lo = _mm256_mul_epu32(data_key, prime32);
+      const __m256i product_hi = _mm256_mul_epu32(_mm256_srli_epi64(data_key, 32), prime32);
+      _mm256_storeu_si256(reinterpret_cast<__m256i *>(acc.data() + 4 * i),
+                          _mm256_add_epi64(product_lo, _mm256_slli_epi64(product_hi, 32)));
+    }
+#elif IA_ARCH_ARM64
+    const uint32x2_t prime32 = vdup_n_u32(XXH_PRIME32_1);
+    for (Mut<usize> i = 0; i < 4; ++i)
+    {
+      const uint64x2_t acc_vec = vld1q_u64(acc.data() + 2 * i);
+      const uint64x2_t key_vec = vreinterpretq_u64_u8(vld1q_u8(secret + 16 * i));
+      const uint64x2_t data_key = veorq_u64(veorq_u64(acc_vec, vshrq_n_u64(acc_vec, 47)), key_vec);
+      const uint64x2_t product_hi = vshlq_n_u64(vmull_u32(vshrn_n_u64(data_key, 32), prime32), 32);
+      vst1q_u64(acc.data() + 2 * i, vmlal_u32(product_hi, vmovn_u64(data_key), prime32));
+    }
+#else
+    for (Mut<usize> i = 0; i < XXH3_ACC_COUNT; ++i)
+    {
+      Mut<u64> acc64 = acc[i];
+      acc64 ^= acc64 >> 47;
+      acc64 ^= read_unaligned<u64>(secret + 8 * i);
+      acc[i] = acc64 * XXH_PRIME32_1;
+    }
+#endif
+  }
+
+  inline auto xxh3_merge_accumulators(Ref<Xxh3Accumulators> acc, const u8 *secret, const u64 start) -> u64
+  {
+    Mut<u64> result = start;
+    for (Mut<usize> i = 0; i < 4; ++i)
+    {
+      result += xxh3_mul128_fold64(acc[2 * i] ^ read_unaligned<u64>(secret + 16 * i),
+                                   acc[2 * i + 1] ^ read_unaligned<u64>(secret + 16 * i + 8));
+    }
+    return xxh3_avalanche(result);
+  }
+
+  inline auto xxh3_init_secret(MutRef<Array<u8, XXH3_SECRET_SIZE>> secret, const u64 seed) -> void
+  {
+    for (Mut<usize> i = 0; i < XXH3_SECRET_SIZE / 16; ++i)
+    {
+      const u64 lo = read_unaligned<u64>(XXH3_DEFAULT_SECRET + 16 * i) + seed;
+      const u64 hi = read_unaligned<u64>(XXH3_DEFAULT_SECRET + 16 * i + 8) - seed;
+      std::memcpy(secret.data() + 16 * i, &lo, sizeof(lo));
+      std::memcpy(secret.data() + 16 * i + 8, &hi, sizeof(hi));
+    }
+  }
+
+  inline auto xxh3_hash_long(MutRef<Xxh3Accumulators> acc, const u8 *input, const usize len, const u8 *secret)
+      -> void
+  {
+    constexpr const usize BLOCK_LEN = XXH3_STRIPE_LEN * XXH3_STRIPES_PER_BLOCK;
+
+    const usize block_count = (len - 1) / BLOCK_LEN;
+    for (Mut<usize> n = 0; n < block_count; ++n)
+    {
+      xxh3_accumulate(acc, input + n * BLOCK_LEN, secret, XXH3_STRIPES_PER_BLOCK);
+      xxh3_scramble(acc, secret + XXH3_SECRET_SIZE - XXH3_STRIPE_LEN);
+    }
+
+    const usize stripes = ((len - 1) - (BLOCK_LEN * block_count)) / XXH3_STRIPE_LEN;
+    xxh3_accumulate(acc, input + block_count * BLOCK_LEN, secret, stripes);
+
+    xxh3_accumulate(acc, input + len - XXH3_STRIPE_LEN,
+                    secret + XXH3_SECRET_SIZE - XXH3_STRIPE_LEN - XXH3_SECRET_LASTACC_START, 1);
+  }
+
+  auto DataOps::hash_xxh3(Ref<String> string, const u64 seed) -> u64
+  {
+    return hash_xxh3(Span<const u8>(reinterpret_cast<const u8 *>(string.data()), string.length()), seed);
+  }
+
+  auto DataOps::hash_xxh3(Ref<Span<const u8>> data, const u64 seed) -> u64
+  {
+    const u8 *input = data.data();
+    const usize len = data.size();
+
+    if (len <= 16)
+    {
+      return xxh3_len_0to16_64(input, len, XXH3_DEFAULT_SECRET, seed);
+    }
+    if (len <= 128)
+    {
+      return xxh3_len_17to128_64(input, len, XXH3_DEFAULT_SECRET, seed);
+    }
+    if (len <= XXH3_MIDSIZE_MAX)
+    {
+      return xxh3_len_129to240_64(input, len, XXH3_DEFAULT_SECRET, seed);
+    }
+
+    Mut<Array<u8, XXH3_SECRET_SIZE>> custom_secret;
+    Mut<const u8 *> secret = XXH3_DEFAULT_SECRET;
+    if (seed != 0)
+    {
+      xxh3_init_secret(custom_secret, seed);
+      secret = custom_secret.data();
+    }
+
+    Mut<Xxh3Accumulators> acc = XXH3_INIT_ACC;
+    xxh3_hash_long(acc, input, len, secret);
+    return xxh3_merge_accumulators(acc, secret + XXH3_SECRET_MERGEACCS_START, static_cast<u64>(len) * XXH_PRIME64_1);
+  }
+
+  auto DataOps::hash_xxh3_128(Ref<String> string, const u64 seed) -> Hash128
+  {
+    return hash_xxh3_128(Span<const u8>(reinterpret_cast<const u8 *>(string.data()), string.length()), seed);
+  }
+
+  auto DataOps::hash_xxh3_128(Ref<Span<const u8>> data, const u64 seed) -> Hash128
+  {
+    const u8 *input = data.data();
+    const usize len = data.size();
+
+    if (len <= 16)
+    {
+      return xxh3_len_0to16_128(input, len, XXH3_DEFAULT_SECRET, seed);
+    }
+    if (len <= 128)
+    {
+      return xxh3_len_17to128_128(input, len, XXH3_DEFAULT_SECRET, seed);
+    }
+    if (len <= XXH3_MIDSIZE_MAX)
+    {
+      return xxh3_len_129to240_128(input, len, XXH3_DEFAULT_SECRET, seed);
+    }
+
+    Mut<Array<u8, XXH3_SECRET_SIZE>> custom_secret;
+    Mut<const u8 *> secret = XXH3_DEFAULT_SECRET;
+    if (seed != 0)
+    {
+      xxh3_init_secret(custom_secret, seed);
+      secret = custom_secret.data();
+    }
+
+    Mut<Xxh3Accumulators> acc = XXH3_INIT_ACC;
+    xxh3_hash_long(acc, input, len, secret);
+    return {
+        xxh3_merge_accumulators(acc, secret + XXH3_SECRET_MERGEACCS_START, static_cast<u64>(len) * XXH_PRIME64_1),
+        xxh3_merge_accumulators(acc, secret + XXH3_SECRET_SIZE - sizeof(acc) - XXH3_SECRET_MERGEACCS_START,
+                                ~(static_cast<u64>(len) * XXH_PRIME64_2)),
+    };
+  }
+
+  // Accumulates `stripes` stripes, scrambling whenever a block of the secret is used up.
+  // `stripes_in_block` carries the position within the current block across calls.
+  inline auto xxh3_consume_stripes(MutRef<Xxh3Accumulators> acc, MutRef<usize> stripes_in_block, const u8 *input,
+                                   Mut<usize> stripes, const u8 *secret) -> const u8 *
+  {
+    Mut<const u8 *> p = input;
+    Mut<const u8 *> key = secret + stripes_in_block * XXH3_SECRET_CONSUME_RATE;
+
+    if (stripes >= XXH3_STRIPES_PER_BLOCK - stripes_in_block)
+    {
+      Mut<usize> this_block = XXH3_STRIPES_PER_BLOCK - stripes_in_block;
+      do
+      {
+        xxh3_accumulate(acc, p, key, this_block);
+        xxh3_scramble(acc, secret + XXH3_SECRET_SIZE - XXH3_STRIPE_LEN);
+        p += this_block * XXH3_STRIPE_LEN;
+        stripes -= this_block;
+        this_block = XXH3_STRIPES_PER_BLOCK;
+        key = secret;
+      } while (stripes >= XXH3_STRIPES_PER_BLOCK);
+      stripes_in_block = 0;
+    }
+
+    if (stripes > 0)
+    {
+      xxh3_accumulate(acc, p, key, stripes);
+      p += stripes * XXH3_STRIPE_LEN;
+      stripes_in_block += stripes;
+    }
+
+    return p;
+  }
+
+  DataOps::Xxh3Hasher::Xxh3Hasher(const u64 seed)
+  {
+    reset(seed);
+  }
+
+  auto DataOps::Xxh3Hasher::reset(const u64 seed) -> void
+  {
+    m_acc = XXH3_INIT_ACC;
+    if (seed == 0)
+    {
+      std::memcpy(m_secret.data(), XXH3_DEFAULT_SECRET, XXH3_SECRET_SIZE);
+    }
+    else
+    {
+      xxh3_init_secret(m_secret, seed);
+    }
+    m_buffered = 0;
+    m_stripes_in_block = 0;
+    m_total_length = 0;
+    m_seed = seed;
+  }
+
+  auto DataOps::Xxh3Hasher::update(Ref<Span<const u8>> data) -> void
+  {
+    if (data.empty())
+    {
+      return;
+    }
+
+    Mut<const u8 *> p = data.data();
+    const u8 *b_end = p + data.size();
+    m_total_length += data.size();
+
+    if (data.size() <= BUFFER_SIZE - m_buffered)
+    {
+      std::memcpy(m_buffer.data() + m_buffered, p, data.size());
+      m_buffered += data.size();
+      return;
+    }
+
+    // The buffer is only flushed once more input is known to follow, so digest() always
+    // has the final stripe available
+    if (m_buffered > 0)
+    {
+      const usize fill = BUFFER_SIZE - m_buffered;
+      std::memcpy(m_buffer.data() + m_buffered, p, fill);
+      p += fill;
+      xxh3_consume_stripes(m_acc, m_stripes_in_block, m_buffer.data(), BUFFER_SIZE / XXH3_STRIPE_LEN,
+                           m_secret.data());
+      m_buffered = 0;
+    }
+
+    if (static_cast<usize>(b_end - p) > BUFFER_SIZE)
+    {
+      const usize stripes = static_cast<usize>(b_end - p - 1) / XXH3_STRIPE_LEN;
+      p = xxh3_consume_stripes(m_acc, m_stripes_in_block, p, stripes, m_secret.data());
+      // Keep the last consumed stripe around in case digest() needs to rebuild a final stripe
+      std::memcpy(m_buffer.data() + BUFFER_SIZE - XXH3_STRIPE_LEN, p - XXH3_STRIPE_LEN, XXH3_STRIPE_LEN);
+    }
+
+    m_buffered = static_cast<usize>(b_end - p);
+    std::memcpy(m_buffer.data(), p, m_buffered);
+  }
+
+  auto DataOps::Xxh3Hasher::digest_long(MutRef<Array<u64, 8>> acc) const -> void
+  {
+    acc = m_acc;
+
+    Mut<const u8 *> last_stripe = nullptr;
+    alignas(64) Mut<Array<u8, XXH3_STRIPE_LEN>> stitched;
+    if (m_buffered >= XXH3_STRIPE_LEN)
+    {
+      Mut<usize> stripes_in_block = m_stripes_in_block;
+      xxh3_consume_stripes(acc, stripes_in_block, m_buffer.data(), (m_buffered - 1) / XXH3_STRIPE_LEN,
+                           m_secret.data());
+      last_stripe = m_buffer.data() + m_buffered - XXH3_STRIPE_LEN;
+    }
+    else
+    {
+      const usize catch_up = XXH3_STRIPE_LEN - m_buffered;
+      std::memcpy(stitched.data(), m_buffer.data() + BUFFER_SIZE - catch_up, catch_up);
+      std::memcpy(stitched.data() + catch_up, m_buffer.data(), m_buffered);
+      last_stripe = stitched.data();
+    }
+
+    xxh3_accumulate(acc, last_stripe, m_secret.data() + XXH3_SECRET_SIZE - XXH3_STRIPE_LEN - XXH3_SECRET_LASTACC_START,
+                    1);
+  }
+
+  auto DataOps::Xxh3Hasher::digest() const -> u64
+  {
+    if (m_total_length <= XXH3_MIDSIZE_MAX)
+    {
+      return hash_xxh3(Span<const u8>(m_buffer.data(), m_buffered), m_seed);
+    }
+
+    Mut<Xxh3Accumulators> acc;
+    digest_long(acc);
+    return xxh3_merge_accumulators(acc, m_secret.data() + XXH3_SECRET_MERGEACCS_START, m_total_length * XXH_PRIME64_1);
+  }
+
+  auto DataOps::Xxh3Hasher::digest_128() const -> Hash128
+  {
+    if (m_total_length <= XXH3_MIDSIZE_MAX)
+    {
+      return hash_xxh3_128(Span<const u8>(m_buffer.data(), m_buffered), m_seed);
+    }
+
+    Mut<Xxh3Accumulators> acc;
+    digest_long(acc);
+    return {
+        xxh3_merge_accumulators(acc, m_secret.data() + XXH3_SECRET_MERGEACCS_START, m_total_length * XXH_PRIME64_1),
+        xxh3_merge_accumulators(acc, m_secret.data() + XXH3_SECRET_SIZE - sizeof(acc) - XXH3_SECRET_MERGEACCS_START,
+                                ~(m_total_length * XXH_PRIME64_2)),
+    };
+  }
+
+  constexpr const u32 FNV1A_32_PRIME = 0x01000193;
+  constexpr const u32 FNV1A_32_OFFSET = 0x811c9dc5;
+
+  auto DataOps::hash_fnv1a(Ref<String> string) -> u32
+  {
+    Mut<u32> hash = FNV1A_32_OFFSET;
+    for (const char c : string)
+    {
+      hash ^= static_cast<u8>(c);
+      hash *= FNV1A_32_PRIME;
+    }
+    return hash;
+  }
+
+  auto DataOps::hash_fnv1a(Ref<Span<const u8>> data) -> u32
+  {
+    Mut<u32> hash = FNV1A_32_OFFSET;
+    const u8 *ptr = data.data();
+
+    for (Mut<usize> i = 0; i < data.size(); ++i)
+    {
+      hash ^= ptr[i];
+      hash *= FNV1A_32_PRIME;
+    }
+    return hash;
+  }
+
+  auto DataOps::Fnv1aHasher::reset() -> void
+  {
+    m_hash = FNV1A_32_OFFSET;
+  }
+
+  auto DataOps::Fnv1aHasher::update(Ref<Span<const u8>> data) -> void
+  {
+    Mut<u32> hash = m_hash;
+    for (const u8 byte : data)
+    {
+      hash ^= byte;
+      hash *= FNV1A_32_PRIME;
+    }
+    m_hash = hash;
+  }
+
+  auto DataOps::Fnv1aHasher::digest() const -> u32
+  {
+    return m_hash;
+  }
+
+  auto DataOps::detect_compression(const Span<const u8> data) -> CompressionType
+  {
+    if (data.size() < 2)
+    {
+      return CompressionType::None;
+    }
+
+    if (data[0] == 0x1F && data[1] == 0x8B)
+    {
+      return CompressionType::Gzip;
+    }
+
+    if (data[0] == 0x78 && (data[1] == 0x01 || data[1] == 0x9C || data[1] == 0xDA))
+    {
+      return CompressionType::Zlib;
+    }
+
+    if (data.size() >= 4 && read_unaligned<u32>(data.data()) == ZSTD_MAGICNUMBER)
+    {
+      return CompressionType::Zstd;
+    }
+
+    if (data.size() >= 4 && read_unaligned<u32>(data.data()) == LZ4F_MAGICNUMBER)
+    {
+      return CompressionType::Lz4;
+    }
+
+    return CompressionType::None;
+  }
+
+  // Per-thread codec state reused by the one-shot functions, so after warm-up they don't
+  // allocate beyond their output buffer.
+  struct ThreadCodecContexts
+  {
+    Mut<ZSTD_CCtx *> zstd_compress{};
+    Mut<ZSTD_DCtx *> zstd_decompress{};
+    Mut<LZ4F_cctx *> lz4_compress{};
+    Mut<LZ4F_dctx *> lz4_decompress{};
+    Mut<z_stream> zlib_deflate{};
+    Mut<z_stream> gzip_deflate{};
+    Mut<z_stream> inflate{};
+    Mut<bool> zlib_deflate_ready{false};
+    Mut<bool> gzip_deflate_ready{false};
+    Mut<bool> inflate_ready{false};
+    Mut<int> zlib_deflate_level{Z_DEFAULT_COMPRESSION};
+    Mut<int> gzip_deflate_level{Z_DEFAULT_COMPRESSION};
+
+    ~ThreadCodecContexts()
+    {
+      ZSTD_freeCCtx(zstd_compress);
+      ZSTD_freeDCtx(zstd_decompress);
+      LZ4F_freeCompressionContext(lz4_compress);
+      LZ4F_freeDecompressionContext(lz4_decompress);
+      if (zlib_deflate_ready)
+      {
+        deflateEnd(&zlib_deflate);
+      }
+      if (gzip_deflate_ready)
+      {
+        deflateEnd(&gzip_deflate);
+      }
+      if (inflate_ready)
+      {
+        inflateEnd(&inflate);
+      }
+    }
+  };
+
+  inline auto thread_codec_contexts() -> MutRef<ThreadCodecContexts>
+  {
+    thread_local Mut<ThreadCodecContexts> contexts;
+    return contexts;
+  }
+
+  inline auto acquire_zstd_cctx() -> Result<ZSTD_CCtx *>
+  {
+    MutRef<ThreadCodecContexts> contexts = thread_codec_contexts();
+    if (!contexts.zstd_compress)
+    {
+      contexts.zstd_compress = ZSTD_createCCtx();
+      if (!contexts.zstd_compress)
+      {
+        return fail("Failed to create ZSTD compression context");
+      }
+    }
+    return contexts.zstd_compress;
+  }
+
+  inline auto acquire_zstd_dctx() -> Result<ZSTD_DCtx *>
+  {
+    MutRef<ThreadCodecContexts> contexts = thread_codec_contexts();
+    if (!contexts.zstd_decompress)
+    {
+      contexts.zstd_decompress = ZSTD_createDCtx();
+      if (!contexts.zstd_decompress)
+      {
+        return fail("Failed to create ZSTD decompression context");
+      }
+    }
+    return contexts.zstd_decompress;
+  }
+
+  inline auto acquire_lz4_cctx() -> Result<LZ4F_cctx *>
+  {
+    MutRef<ThreadCodecContexts> contexts = thread_codec_contexts();
+    if (!contexts.lz4_compress && LZ4F_isError(LZ4F_createCompressionContext(&contexts.lz4_compress, LZ4F_VERSION)))
+    {
+      contexts.lz4_compress = nullptr;
+      return fail("Failed to create LZ4 compression context");
+    }
+    return contexts.lz4_compress;
+  }
+
+  // Returns a decompression context ready for a new frame
+  inline auto acquire_lz4_dctx() -> Result<LZ4F_dctx *>
+  {
+    MutRef<ThreadCodecContexts> contexts = thread_codec_contexts();
+    if (!contexts.lz4_decompress)
+    {
+      if (LZ4F_isError(LZ4F_createDecompressionContext(&contexts.lz4_decompress, LZ4F_VERSION)))
+      {
+        contexts.lz4_decompress = nullptr;
+        return fail("Failed to create LZ4 decompression context");
+      }
+      return contexts.lz4_decompress;
+    }
+    LZ4F_resetDecompressionContext(contexts.lz4_decompress);
+    return contexts.lz4_decompress;
+  }
+
+  // Returns a reset deflate stream producing gzip (`gzip` true) or zlib framing
+  inline auto acquire_deflate_stream(const bool gzip, const int level = Z_DEFAULT_COMPRESSION) -> Result<z_stream *>
+  {
+    MutRef<ThreadCodecContexts> contexts = thread_codec_contexts();
+    MutRef<z_stream> zs = gzip ? contexts.gzip_deflate : contexts.zlib_deflate;
+    MutRef<bool> ready = gzip ? contexts.gzip_deflate_ready : contexts.zlib_deflate_ready;
+    MutRef<int> current_level = gzip ? contexts.gzip_deflate_level : contexts.zlib_deflate_level;
+
+    if (!ready)
+    {
+      if (deflateInit2(&zs, level, Z_DEFLATED, gzip ? 15 + 16 : 15, 8, Z_DEFAULT_STRATEGY) != Z_OK)
+      {
+        return fail("Failed to initialize {} deflate", gzip ? "gzip" : "zlib");
+      }
+      ready = true;
+      current_level = level;
+      return &zs;
+    }
+
+    if (deflateReset(&zs) != Z_OK)
+    {
+      return fail("Failed to reset {} deflate", gzip ? "gzip" : "zlib");
+    }
+    if (level != current_level)
+    {
+      if (deflateParams(&zs, level, Z_DEFAULT_STRATEGY) != Z_OK)
+      {
+        return fail("Invalid {} compression level {}", gzip ? "gzip" : "zlib", level);
+      }
+      current_level = level;
+    }
+    return &zs;
+  }
+
+  // Returns a reset inflate stream accepting both gzip and zlib framing
+  inline auto acquire_inflate_stream() -> Result<z_stream *>
+  {
+    MutRef<ThreadCodecContexts> contexts = thread_codec_contexts();
+    if (!contexts.inflate_ready)
+    {
+      if (inflateInit2(&contexts.inflate, 15 + 32) != Z_OK)
+      {
+        return fail("Failed to initialize zlib inflate");
+      }
+      contexts.inflate_ready = true;
+    }
+    else if (inflateReset(&contexts.inflate) != Z_OK)
+    {
+      return fail("Failed to reset zlib inflate");
+    }
+    return &contexts.inflate;
+  }
+
+  inline auto deflate_into(Ref<Span<const u8>> data, Ref<Span<u8>> out, const bool gzip,
+                           const int level = Z_DEFAULT_COMPRESSION) -> Result<usize>
+  {
+    z_stream *zs = AU_TRY(acquire_deflate_stream(gzip, level));
+
+    zs->next_in = const_cast<Bytef *>(data.data());
+    zs->avail_in = static_cast<uInt>(data.size());
+    zs->next_out = reinterpret_cast<Bytef *>(out.data());
+    zs->avail_out = static_cast<uInt>(out.size());
+
+    const int ret = deflate(zs, Z_FINISH);
+    if (ret != Z_STREAM_END)
+    {
+      return fail("Failed to deflate: output buffer too small");
+    }
+    return static_cast<usize>(zs->total_out);
+  }
+
+  inline auto deflate_bound(const usize size, const bool gzip) -> usize
+  {
+    z_stream *zs = acquire_deflate_stream(gzip).value_or(nullptr);
+    if (!zs)
+    {
+      // Same as deflateBound() for a stream it knows nothing about
+      return compressBound(static_cast<uLong>(size)) + (gzip ? 18 : 0);
+    }
+    return deflateBound(zs, static_cast<uLong>(size));
+  }
+
+  auto DataOps::zlib_inflate(Ref<Span<const u8>> data) -> Result<Vec<u8>>
+  {
+    z_stream *zs = AU_TRY(acquire_inflate_stream());
+
+    zs->next_in = const_cast<Bytef *>(data.data());
+    zs->avail_in = static_cast<uInt>(data.size());
+
+    Mut<Vec<u8>> out_buffer;
+    const usize guess_size = data.size() < 1024 ? data.size() * 4 : data.size() * 2;
+    out_buffer.resize(guess_size);
+
+    zs->next_out = reinterpret_cast<Bytef *>(out_buffer.data());
+    zs->avail_out = static_cast<uInt>(out_buffer.size());
+
+    Mut<int> ret;
+    do
+    {
+      if (zs->avail_out == 0)
+      {
+        const usize current_pos = zs->total_out;
+        const usize new_size = out_buffer.size() * 2;
+        out_buffer.resize(new_size);
+
+        zs->next_out = reinterpret_cast<Bytef *>(out_buffer.data() + current_pos);
+        zs->avail_out = static_cast<uInt>(new_size - current_pos);
+      }
+
+      ret = inflate(zs, Z_NO_FLUSH);
+
+    } while (ret == Z_OK);
+
+    if (ret != Z_STREAM_END)
+    {
+      return fail("Failed to inflate: corrupt data or stream error");
+    }
+
+    out_buffer.resize(zs->total_out);
+
+    return out_buffer;
+  }
+
+  auto DataOps::zlib_inflate_into(Ref<Span<const u8>> data, Ref<Span<u8>> out) -> Result<usize>
+  {
+    z_stream *zs = AU_TRY(acquire_inflate_stream());
+
+    zs->next_in = const_cast<Bytef *>(data.data());
+    zs->avail_in = static_cast<uInt>(data.size());
+    zs->next_out = reinterpret_cast<Bytef *>(out.data());
+    zs->avail_out = static_cast<uInt>(out.size());
+
+    const int ret = inflate(zs, Z_FINISH);
+    if (ret == Z_STREAM_END)
+    {
+      return static_cast<usize>(zs->total_out);
+    }
+
+    if (ret == Z_BUF_ERROR && zs->avail_out == 0)
+    {
+      return fail("Failed to inflate: output buffer too small");
+    }
+    return fail("Failed to inflate: corrupt data or stream error");
+  }
+
+  auto DataOps::zlib_deflate(Ref<Span<const u8>> data) -> Result<Vec<u8>>
+  {
+    Mut<Vec<u8>> out_buffer;
+    out_buffer.resize(deflate_bound(data.size(), false));
+
+    const usize size = AU_TRY(deflate_into(data, out_buffer, false));
+    out_buffer.resize(size);
+    return out_buffer;
+  }
+
+  auto DataOps::zlib_deflate_into(Ref<Span<const u8>> data, Ref<Span<u8>> out) -> Result<usize>
+  {
+    return deflate_into(data, out, false);
+  }
+
+  auto DataOps::zlib_deflate_bound(const usize size) -> usize
+  {
+    return deflate_bound(size, false);
+  }
+
+  // `ddict` may be null. Dictionaries are always passed explicitly rather than referenced on the
+  // shared context, so a dictionary can't leak into a later call on the same thread.
+  inline auto zstd_inflate_with(Ref<Span<const u8>> data, const ZSTD_DDict *ddict) -> Result<Vec<u8>>
+  {
+    const unsigned long long content_size = ZSTD_getFrameContentSize(data.data(), data.size());
+
+    if (content_size == ZSTD_CONTENTSIZE_ERROR)
+    {
+      return fail("Failed to inflate: Not valid ZSTD compressed data");
+    }
+
+    ZSTD_DCtx *dctx = AU_TRY(acquire_zstd_dctx());
+
+    // The header only sizes the first frame; multi-frame input (e.g. seekable archives) streams
+    if (content_size != ZSTD_CONTENTSIZE_UNKNOWN &&
+        ZSTD_findFrameCompressedSize(data.data(), data.size()) == data.size())
+    {
+      Mut<Vec<u8>> out_buffer;
+      out_buffer.resize(static_cast<usize>(content_size));
+
+      const usize d_size =
+          ZSTD_decompress_usingDDict(dctx, out_buffer.data(), out_buffer.size(), data.data(), data.size(), ddict);
+
+      if (ZSTD_isError(d_size))
+      {
         return fail("Failed to inflate: {}", ZSTD_getErrorName(d_size));
       }
 
-      return out_buffer;
+      return out_buffer;
+    }
+
+    ZSTD_DCtx_reset(dctx, ZSTD_reset_session_and_parameters);
+    ZSTD_DCtx_refDDict(dctx, ddict);
+
+    Mut<Vec<u8>> out_buffer;
+    out_buffer.resize(data.size() * 2);
+
+    Mut<ZSTD_inBuffer> input = {data.data(), data.size(), 0};
+    Mut<ZSTD_outBuffer> output = {out_buffer.data(), out_buffer.size(), 0};
+
+    Mut<usize> ret;
+    do
+    {
+      ret = ZSTD_decompressStream(dctx, &output, &input);
+
+      if (ZSTD_isError(ret))
+      {
+        ZSTD_DCtx_reset(dctx, ZSTD_reset_session_and_parameters);
+        return fail("Failed to inflate: {}", ZSTD_getErrorName(ret));
+      }
+
+      if (output.pos == output.size)
+      {
+        const usize new_size = out_buffer.size() * 2;
+        out_buffer.resize(new_size);
+        output.dst = out_buffer.data();
+        output.size = new_size;
+      }
+      else if (ret != 0 && input.pos == input.size)
+      {
+        ZSTD_DCtx_reset(dctx, ZSTD_reset_session_and_parameters);
+        return fail("Failed to inflate: Truncated ZSTD stream");
+      }
+
+      // Keep going across concatenated frames
+    } while (ret != 0 || input.pos < input.size);
+
+    ZSTD_DCtx_reset(dctx, ZSTD_reset_session_and_parameters);
+    out_buffer.resize(output.pos);
+
+    return out_buffer;
+  }
+
+  inline auto zstd_inflate_into_with(Ref<Span<const u8>> data, Ref<Span<u8>> out, const ZSTD_DDict *ddict)
+      -> Result<usize>
+  {
+    ZSTD_DCtx *dctx = AU_TRY(acquire_zstd_dctx());
+
+    const usize d_size = ZSTD_decompress_usingDDict(dctx, out.data(), out.size(), data.data(), data.size(), ddict);
+    if (ZSTD_isError(d_size))
+    {
+      return fail("Failed to inflate: {}", ZSTD_getErrorName(d_size));
+    }
+    return d_size;
+  }
+
+  auto DataOps::zstd_inflate(Ref<Span<const u8>> data) -> Result<Vec<u8>>
+  {
+    return zstd_inflate_with(data, nullptr);
+  }
+
+  auto DataOps::zstd_inflate_into(Ref<Span<const u8>> data, Ref<Span<u8>> out) -> Result<usize>
+  {
+    return zstd_inflate_into_with(data, out, nullptr);
+  }
+
+  auto DataOps::zstd_deflate(Ref<Span<const u8>> data) -> Result<Vec<u8>>
+  {
+    Mut<Vec<u8>> out_buffer;
+    out_buffer.resize(ZSTD_compressBound(data.size()));
+
+    const usize compressed_size = AU_TRY(zstd_deflate_into(data, out_buffer));
+
+    out_buffer.resize(compressed_size);
+    return out_buffer;
+  }
+
+  auto DataOps::zstd_deflate_into(Ref<Span<const u8>> data, Ref<Span<u8>> out) -> Result<usize>
+  {
+    ZSTD_CCtx *cctx = AU_TRY(acquire_zstd_cctx());
+
+    const usize compressed_size = ZSTD_compressCCtx(cctx, out.data(), out.size(), data.data(), data.size(), 3);
+    if (ZSTD_isError(compressed_size))
+    {
+      return fail("Failed to deflate: {}", ZSTD_getErrorName(compressed_size));
+    }
+    return compressed_size;
+  }
+
+  auto DataOps::zstd_deflate_bound(const usize size) -> usize
+  {
+    return ZSTD_compressBound(size);
+  }
+
+  struct DataOps::ZstdDictionary::Impl
+  {
+    Mut<ZSTD_CDict *> cdict{};
+    Mut<ZSTD_DDict *> ddict{};
+    Mut<u32> id{};
+    Mut<i32> level{};
+
+    ~Impl()
+    {
+      ZSTD_freeCDict(cdict);
+      ZSTD_freeDDict(ddict);
+    }
+  };
+
+  auto DataOps::ZstdDictionary::create(Ref<Span<const u8>> dictionary, const i32 level) -> Result<ZstdDictionary>
+  {
+    if (dictionary.empty())
+    {
+      return fail("Zstd dictionary is empty");
+    }
+
+    Mut<Box<Impl>> impl = make_box<Impl>();
+    impl->cdict = ZSTD_createCDict(dictionary.data(), dictionary.size(), level);
+    impl->ddict = ZSTD_createDDict(dictionary.data(), dictionary.size());
+    if (!impl->cdict || !impl->ddict)
+    {
+      return fail("Failed to load zstd dictionary");
+    }
+
+    // Raw content dictionaries (no ZDICT header) report id 0
+    impl->id = ZSTD_getDictID_fromDict(dictionary.data(), dictionary.size());
+    impl->level = level;
+
+    return ZstdDictionary(std::move(impl));
+  }
+
+  DataOps::ZstdDictionary::ZstdDictionary(Mut<Box<Impl>> impl) : m_impl(std::move(impl))
+  {
+  }
+
+  DataOps::ZstdDictionary::ZstdDictionary(ForwardRef<ZstdDictionary> other) = default;
+  auto DataOps::ZstdDictionary::operator=(ForwardRef<ZstdDictionary> other) -> MutRef<ZstdDictionary> = default;
+  DataOps::ZstdDictionary::~ZstdDictionary() = default;
+
+  auto DataOps::ZstdDictionary::id() const -> u32
+  {
+    return m_impl->id;
+  }
+
+  auto DataOps::ZstdDictionary::level() const -> i32
+  {
+    return m_impl->level;
+  }
+
+  auto DataOps::zstd_train_dictionary(const Span<const Span<const u8>> samples, const usize max_size) -> Result<Vec<u8>>
+  {
+    Mut<usize> total_size = 0;
+    for (Ref<Span<const u8>> sample : samples)
+    {
+      total_size += sample.size();
+    }
+
+    Mut<Vec<u8>> sample_buffer;
+    Mut<Vec<usize>> sample_sizes;
+    sample_buffer.reserve(total_size);
+    sample_sizes.reserve(samples.size());
+    for (Ref<Span<const u8>> sample : samples)
+    {
+      sample_buffer.insert(sample_buffer.end(), sample.begin(), sample.end());
+      sample_sizes.push_back(sample.size());
+    }
+
+    Mut<Vec<u8>> dictionary;
+    dictionary.resize(max_size);
+
+    const usize dict_size = ZDICT_trainFromBuffer(dictionary.data(), dictionary.size(), sample_buffer.data(),
+                                                  sample_sizes.data(), static_cast<unsigned>(sample_sizes.size()));
+    if (ZDICT_isError(dict_size))
+    {
+      return fail("Failed to train zstd dictionary: {}", ZDICT_getErrorName(dict_size));
+    }
+
+    dictionary.resize(dict_size);
+    return dictionary;
+  }
+
+  auto DataOps::zstd_inflate(Ref<Span<const u8>> data, Ref<ZstdDictionary> dictionary) -> Result<Vec<u8>>
+  {
+    return zstd_inflate_with(data, dictionary.m_impl->ddict);
+  }
+
+  auto DataOps::zstd_inflate_into(Ref<Span<const u8>> data, Ref<Span<u8>> out, Ref<ZstdDictionary> dictionary)
+      -> Result<usize>
+  {
+    return zstd_inflate_into_with(data, out, dictionary.m_impl->ddict);
+  }
+
+  auto DataOps::zstd_deflate(Ref<Span<const u8>> data, Ref<ZstdDictionary> dictionary) -> Result<Vec<u8>>
+  {
+    Mut<Vec<u8>> out_buffer;
+    out_buffer.resize(ZSTD_compressBound(data.size()));
+
+    const usize compressed_size = AU_TRY(zstd_deflate_into(data, out_buffer, dictionary));
+
+    out_buffer.resize(compressed_size);
+    return out_buffer;
+  }
+
+  auto DataOps::zstd_deflate_into(Ref<Span<const u8>> data, Ref<Span<u8>> out, Ref<ZstdDictionary> dictionary)
+      -> Result<usize>
+  {
+    ZSTD_CCtx *cctx = AU_TRY(acquire_zstd_cctx());
+
+    const usize compressed_size = ZSTD_compress_usingCDict(cctx, out.data(), out.size(), data.data(), data.size(),
+                                                           dictionary.m_impl->cdict);
+    if (ZSTD_isError(compressed_size))
+    {
+      return fail("Failed to deflate: {}", ZSTD_getErrorName(compressed_size));
+    }
+    return compressed_size;
+  }
+
+  auto DataOps::gzip_deflate(Ref<Span<const u8>> data) -> Result<Vec<u8>>
+  {
+    Mut<Vec<u8>> out_buffer;
+    out_buffer.resize(deflate_bound(data.size(), true));
+
+    const usize size = AU_TRY(deflate_into(data, out_buffer, true));
+    out_buffer.resize(size);
+    return out_buffer;
+  }
+
+  auto DataOps::gzip_deflate_into(Ref<Span<const u8>> data, Ref<Span<u8>> out) -> Result<usize>
+  {
+    return deflate_into(data, out, true);
+  }
+
+  auto DataOps::gzip_deflate_bound(const usize size) -> usize
+  {
+    return deflate_bound(size, true);
+  }
+
+  auto DataOps::gzip_inflate(Ref<Span<const u8>> data) -> Result<Vec<u8>>
+  {
+    return zlib_inflate(data);
+  }
+
+  auto DataOps::gzip_inflate_into(Ref<Span<const u8>> data, Ref<Span<u8>> out) -> Result<usize>
+  {
+    return zlib_inflate_into(data, out);
+  }
+
+  // LZ4 frames carry the content size so lz4_inflate can allocate once. Blocks are linked (later
+  // blocks may reference earlier ones) for a better ratio; autoFlush skips LZ4F's internal staging copy.
+  inline auto lz4_preferences(const usize size, const i32 level) -> LZ4F_preferences_t
+  {
+    Mut<LZ4F_preferences_t> preferences{};
+    preferences.frameInfo.blockMode = LZ4F_blockLinked;
+    preferences.frameInfo.contentSize = size;
+    preferences.compressionLevel = level;
+    preferences.autoFlush = 1;
+    return preferences;
+  }
+
+  inline auto lz4_compress_frame(Ref<Span<const u8>> data, Ref<Span<u8>> out, const i32 level) -> Result<usize>
+  {
+    LZ4F_cctx *cctx = AU_TRY(acquire_lz4_cctx());
+    const LZ4F_preferences_t preferences = lz4_preferences(data.size(), level);
+
+    if (out.size() < LZ4F_compressFrameBound(data.size(), &preferences))
+    {
+      return fail("Failed to deflate: output buffer too small");
+    }
+
+    Mut<usize> written = LZ4F_compressBegin(cctx, out.data(), out.size(), &preferences);
+    if (LZ4F_isError(written))
+    {
+      return fail("Failed to deflate: {}", LZ4F_getErrorName(written));
+    }
+
+    const usize body_size =
+        LZ4F_compressUpdate(cctx, out.data() + written, out.size() - written, data.data(), data.size(), nullptr);
+    if (LZ4F_isError(body_size))
+    {
+      return fail("Failed to deflate: {}", LZ4F_getErrorName(body_size));
+    }
+    written += body_size;
+
+    const usize end_size = LZ4F_compressEnd(cctx, out.data() + written, out.size() - written, nullptr);
+    if (LZ4F_isError(end_size))
+    {
+      return fail("Failed to deflate: {}", LZ4F_getErrorName(end_size));
+    }
+    return written + end_size;
+  }
+
+  // Decodes every LZ4 frame in data[in_pos..] into `out`, starting at `out_pos`. When `out` is full,
+  // grow() must return a larger buffer that keeps the bytes decoded so far, or an empty span to give up.
+  template<typename Grow>
+  inline auto lz4_decode_frames(LZ4F_dctx *dctx, Ref<Span<const u8>> data, Mut<usize> in_pos, Mut<Span<u8>> out,
+                                Mut<usize> out_pos, Ref<Grow> grow) -> Result<usize>
+  {
+    Mut<usize> hint = 1;
+    while (in_pos < data.size() || hint != 0)
+    {
+      if (out_pos == out.size())
+      {
+        out = grow();
+        if (out.size() <= out_pos)
+        {
+          return fail("Failed to inflate: output buffer too small");
+        }
+      }
+      else if (in_pos == data.size())
+      {
+        return fail("Failed to inflate: Truncated LZ4 frame");
+      }
+
+      Mut<usize> src_size = data.size() - in_pos;
+      Mut<usize> dst_size = out.size() - out_pos;
+      hint = LZ4F_decompress(dctx, out.data() + out_pos, &dst_size, data.data() + in_pos, &src_size, nullptr);
+      if (LZ4F_isError(hint))
+      {
+        LZ4F_resetDecompressionContext(dctx);
+        return fail("Failed to inflate: {}", LZ4F_getErrorName(hint));
+      }
+      in_pos += src_size;
+      out_pos += dst_size;
+    }
+    return out_pos;
+  }
+
+  auto DataOps::lz4_inflate(Ref<Span<const u8>> data) -> Result<Vec<u8>>
+  {
+    LZ4F_dctx *dctx = AU_TRY(acquire_lz4_dctx());
+
+    Mut<LZ4F_frameInfo_t> info{};
+    Mut<usize> header_size = data.size();
+    const usize ret = LZ4F_getFrameInfo(dctx, &info, data.data(), &header_size);
+    if (LZ4F_isError(ret))
+    {
+      LZ4F_resetDecompressionContext(dctx);
+      return fail("Failed to inflate: {}", LZ4F_getErrorName(ret));
+    }
+
+    // The header sizes the first frame only, concatenated frames grow the buffer
+    Mut<Vec<u8>> out_buffer;
+    out_buffer.resize(info.contentSize ? static_cast<usize>(info.contentSize) : data.size() * 2);
+
+    const auto grow = [&out_buffer]() -> Span<u8> {
+      out_buffer.resize(std::max<usize>(out_buffer.size() * 2, 64));
+      return out_buffer;
+    };
+    const usize size = AU_TRY(lz4_decode_frames(dctx, data, header_size, out_buffer, 0, grow));
+
+    out_buffer.resize(size);
+    return out_buffer;
+  }
+
+  auto DataOps::lz4_deflate(Ref<Span<const u8>> data) -> Result<Vec<u8>>
+  {
+    return lz4_deflate(data, CompressionOptions{});
+  }
+
+  auto DataOps::lz4_deflate(Ref<Span<const u8>> data, Ref<CompressionOptions> options) -> Result<Vec<u8>>
+  {
+    const i32 level = options.level.value_or(0);
+    const LZ4F_preferences_t preferences = lz4_preferences(data.size(), level);
+
+    Mut<Vec<u8>> out_buffer;
+    out_buffer.resize(LZ4F_compressFrameBound(data.size(), &preferences));
+
+    const usize size = AU_TRY(lz4_compress_frame(data, out_buffer, level));
+    out_buffer.resize(size);
+    return out_buffer;
+  }
+
+  auto DataOps::lz4_inflate_into(Ref<Span<const u8>> data, Ref<Span<u8>> out) -> Result<usize>
+  {
+    LZ4F_dctx *dctx = AU_TRY(acquire_lz4_dctx());
+    return lz4_decode_frames(dctx, data, 0, out, 0, []() -> Span<u8> { return {}; });
+  }
+
+  auto DataOps::lz4_deflate_into(Ref<Span<const u8>> data, Ref<Span<u8>> out) -> Result<usize>
+  {
+    return lz4_compress_frame(data, out, 0);
+  }
+
+  auto DataOps::lz4_deflate_bound(const usize size) -> usize
+  {
+    const LZ4F_preferences_t preferences = lz4_preferences(size, 0);
+    return LZ4F_compressFrameBound(size, &preferences);
+  }
+
+  auto DataOps::zstd_deflate(Ref<Span<const u8>> data, Ref<CompressionOptions> options) -> Result<Vec<u8>>
+  {
+    const i32 level = options.level.value_or(ZSTD_CLEVEL_DEFAULT);
+    if (options.workers <= 1)
+    {
+      Mut<Vec<u8>> out_buffer;
+      out_buffer.resize(ZSTD_compressBound(data.size()));
+
+      ZSTD_CCtx *cctx = AU_TRY(acquire_zstd_cctx());
+      const usize compressed_size =
+          ZSTD_compressCCtx(cctx, out_buffer.data(), out_buffer.size(), data.data(), data.size(), level);
+      if (ZSTD_isError(compressed_size))
+      {
+        return fail("Failed to deflate: {}", ZSTD_getErrorName(compressed_size));
+      }
+
+      out_buffer.resize(compressed_size);
+      return out_buffer;
+    }
+
+    ZSTD_CCtx *cctx = AU_TRY(acquire_zstd_cctx());
+    ZSTD_CCtx_reset(cctx, ZSTD_reset_session_and_parameters);
+    ZSTD_CCtx_setParameter(cctx, ZSTD_c_compressionLevel, level);
+    // Builds of libzstd without ZSTD_MULTITHREAD reject this, compression then stays single threaded
+    ZSTD_CCtx_setParameter(cctx, ZSTD_c_nbWorkers, static_cast<int>(options.workers));
+
+    Mut<Vec<u8>> out_buffer;
+    out_buffer.resize(ZSTD_compressBound(data.size()));
+
+    const usize compressed_size = ZSTD_compress2(cctx, out_buffer.data(), out_buffer.size(), data.data(), data.size());
+    ZSTD_CCtx_reset(cctx, ZSTD_reset_session_and_parameters);
+    if (ZSTD_isError(compressed_size))
+    {
+      return fail("Failed to deflate: {}", ZSTD_getErrorName(compressed_size));
+    }
+
+    out_buffer.resize(compressed_size);
+    return out_buffer;
+  }
+
+  // Tag for DataOps' own tasks on the default scheduler, away from the small tags callers cancel
+  constexpr const AsyncOps::TaskTag DATA_OPS_TASK_TAG = 0x4441'5441'4F50'5300; // "DATAOPS"
+
+  // Runs fn(0) .. fn(task_count - 1) on the AsyncOps workers, with the calling thread helping out.
+  // Runs inline when the default scheduler isn't started. Fails if any task was cancelled before it
+  // ran, since its share of the output was then never produced.
+  template<typename Fn> inline auto run_on_workers(const usize task_count, Ref<Fn> fn) -> Result<void>
+  {
+    if (task_count <= 1 || AsyncOps::get_worker_count() == 0)
+    {
+      for (Mut<usize> i = 0; i < task_count; ++i)
+      {
+        fn(i);
+      }
+      return {};
+    }
+
+    Mut<AsyncOps::Schedule> schedule;
+    Mut<std::atomic<usize>> tasks_run{0};
+    for (Mut<usize> i = 0; i < task_count; ++i)
+    {
+      AsyncOps::schedule_task(
+          [&fn, &tasks_run, i](const AsyncOps::WorkerId) {
+            fn(i);
+            tasks_run.fetch_add(1, std::memory_order_relaxed);
+          },
+          DATA_OPS_TASK_TAG, &schedule);
+    }
+    AsyncOps::wait_for_schedule_completion(&schedule);
+
+    if (tasks_run.load(std::memory_order_relaxed) != task_count)
+    {
+      return fail("{} of {} worker tasks were cancelled", task_count - tasks_run.load(std::memory_order_relaxed),
+                  task_count);
+    }
+    return {};
+  }
+
+  inline auto append_u32_le(MutRef<Vec<u8>> out, const u32 value) -> void
+  {
+    const u8 bytes[4] = {static_cast<u8>(value), static_cast<u8>(value >> 8), static_cast<u8>(value >> 16),
+                         static_cast<u8>(value >> 24)};
+    out.insert(out.end(), std::begin(bytes), std::end(bytes));
+  }
+
+  // Parallel gzip splits the input into blocks compressed independently as raw deflate, each primed
+  // with the 32 KiB of input preceding it so the ratio stays close to a single stream. Blocks end on
+  // a byte boundary (sync flush), so concatenating them forms one valid deflate stream; the CRC of
+  // the whole input is stitched together from per-block CRCs.
+  constexpr const usize PARALLEL_GZIP_BLOCK_SIZE = 1024 * 1024;
+  constexpr const usize DEFLATE_WINDOW_SIZE = 32 * 1024;
+
+  struct ParallelGzipBlock
+  {
+    Mut<Vec<u8>> compressed;
+    Mut<uLong> crc{};
+    Mut<bool> failed{false};
+  };
+
+  inline auto compress_gzip_block(MutRef<z_stream> zs, Ref<Span<const u8>> data, const usize block_index,
+                                  const usize block_count, MutRef<ParallelGzipBlock> block) -> void
+  {
+    const usize begin = block_index * PARALLEL_GZIP_BLOCK_SIZE;
+    const usize size = std::min(PARALLEL_GZIP_BLOCK_SIZE, data.size() - begin);
+    const bool last = block_index + 1 == block_count;
+
+    block.crc = ::crc32(0, data.data() + begin, static_cast<uInt>(size));
+
+    if (deflateReset(&zs) != Z_OK)
+    {
+      block.failed = true;
+      return;
+    }
+
+    if (begin > 0)
+    {
+      const usize window = std::min(DEFLATE_WINDOW_SIZE, begin);
+      deflateSetDictionary(&zs, data.data() + begin - window, static_cast<uInt>(window));
+    }
+
+    // Usually room for the block and its sync flush marker, grown below when it isn't
+    block.compressed.resize(deflateBound(&zs, static_cast<uLong>(size)) + 16);
+    zs.next_in = const_cast<Bytef *>(data.data() + begin);
+    zs.avail_in = static_cast<uInt>(size);
+
+    // A flush that fills the output exactly may still have part of the marker pending inside zlib,
+    // it is only complete once deflate returns with output space left
+    Mut<usize> produced = 0;
+    Mut<int> ret = Z_OK;
+    while (true)
+    {
+      zs.next_out = block.compressed.data() + produced;
+      zs.avail_out = static_cast<uInt>(block.compressed.size() - produced);
+      ret = deflate(&zs, last ? Z_FINISH : Z_SYNC_FLUSH);
+      produced = block.compressed.size() - zs.avail_out;
+
+      if (ret == Z_STREAM_END || ret == Z_STREAM_ERROR || zs.avail_out != 0)
+      {
+        break;
+      }
+      block.compressed.resize(block.compressed.size() * 2);
+    }
+
+    // Z_BUF_ERROR just means a repeated flush found nothing left to write
+    if ((last && ret != Z_STREAM_END) || (!last && ((ret != Z_OK && ret != Z_BUF_ERROR) || zs.avail_in != 0)))
+    {
+      block.failed = true;
+      return;
+    }
+
+    block.compressed.resize(produced);
+  }
+
+  inline auto parallel_gzip_deflate(Ref<Span<const u8>> data, const int level, const u32 workers)
+      -> Result<Vec<u8>>
+  {
+    const usize block_count = (data.size() + PARALLEL_GZIP_BLOCK_SIZE - 1) / PARALLEL_GZIP_BLOCK_SIZE;
+    const usize task_count = std::min<usize>(workers, block_count);
+
+    Mut<Vec<ParallelGzipBlock>> blocks(block_count);
+
+    // Each task strides over the blocks with a single raw deflate stream
+    const auto run_task = [&](const usize task_index) {
+      Mut<z_stream> zs{};
+      if (deflateInit2(&zs, level, Z_DEFLATED, -15, 8, Z_DEFAULT_STRATEGY) != Z_OK)
+      {
+        for (Mut<usize> i = task_index; i < block_count; i += task_count)
+        {
+          blocks[i].failed = true;
+        }
+        return;
+      }
+
+      for (Mut<usize> i = task_index; i < block_count; i += task_count)
+      {
+        compress_gzip_block(zs, data, i, block_count, blocks[i]);
+      }
+      deflateEnd(&zs);
+    };
+
+    AU_TRY_PURE(run_on_workers(task_count, run_task));
+
+    Mut<usize> total_size = 10 + 8;
+    Mut<uLong> crc = ::crc32(0, nullptr, 0);
+    for (Ref<ParallelGzipBlock> block : blocks)
+    {
+      if (block.failed)
+      {
+        return fail("Failed to deflate");
+      }
+      total_size += block.compressed.size();
+    }
+
+    Mut<Vec<u8>> out_buffer;
+    out_buffer.reserve(total_size);
+
+    // Header: magic, deflate, no flags, no mtime, no extra flags, unknown OS
+    constexpr const u8 GZIP_HEADER[10] = {0x1F, 0x8B, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xFF};
+    out_buffer.insert(out_buffer.end(), std::begin(GZIP_HEADER), std::end(GZIP_HEADER));
+
+    for (Mut<usize> i = 0; i < block_count; ++i)
+    {
+      Ref<ParallelGzipBlock> block = blocks[i];
+      out_buffer.insert(out_buffer.end(), block.compressed.begin(), block.compressed.end());
+
+      const usize block_size = std::min(PARALLEL_GZIP_BLOCK_SIZE, data.size() - i * PARALLEL_GZIP_BLOCK_SIZE);
+      crc = ::crc32_combine(crc, block.crc, static_cast<z_off_t>(block_size));
+    }
+
+    // Trailer: CRC32 and ISIZE (input size mod 2^32), both little-endian
+    append_u32_le(out_buffer, static_cast<u32>(crc));
+    append_u32_le(out_buffer, static_cast<u32>(data.size()));
+
+    return out_buffer;
+  }
+
+  auto DataOps::gzip_deflate(Ref<Span<const u8>> data, Ref<CompressionOptions> options) -> Result<Vec<u8>>
+  {
+    const int level = options.level.value_or(Z_DEFAULT_COMPRESSION);
+    if (level < Z_DEFAULT_COMPRESSION || level > Z_BEST_COMPRESSION)
+    {
+      return fail("Invalid gzip compression level {}", level);
+    }
+
+    if (options.workers > 1 && data.size() > PARALLEL_GZIP_BLOCK_SIZE && AsyncOps::get_worker_count() > 0)
+    {
+      return parallel_gzip_deflate(data, level, options.workers);
+    }
+
+    Mut<Vec<u8>> out_buffer;
+    out_buffer.resize(deflate_bound(data.size(), true));
+
+    const usize size = AU_TRY(deflate_into(data, out_buffer, true, level));
+    out_buffer.resize(size);
+    return out_buffer;
+  }
+
+  auto DataOps::compress(const CompressionType type, Ref<Span<const u8>> data) -> Result<Vec<u8>>
+  {
+    return compress(type, data, CompressionOptions{});
+  }
+
+  auto DataOps::compress(const CompressionType type, Ref<Span<const u8>> data, Ref<CompressionOptions> options)
+      -> Result<Vec<u8>>
+  {
+    switch (type)
+    {
+    case CompressionType::None:
+      return Vec<u8>(data.begin(), data.end());
+
+    case CompressionType::Gzip:
+      return gzip_deflate(data, options);
+
+    case CompressionType::Zlib: {
+      const int level = options.level.value_or(Z_DEFAULT_COMPRESSION);
+      if (level < Z_DEFAULT_COMPRESSION || level > Z_BEST_COMPRESSION)
+      {
+        return fail("Invalid zlib compression level {}", level);
+      }
+
+      Mut<Vec<u8>> out_buffer;
+      out_buffer.resize(deflate_bound(data.size(), false));
+
+      const usize size = AU_TRY(deflate_into(data, out_buffer, false, level));
+      out_buffer.resize(size);
+      return out_buffer;
+    }
+
+    case CompressionType::Zstd:
+      return zstd_deflate(data, options);
+
+    case CompressionType::Lz4:
+      return lz4_deflate(data, options);
+    }
+
+    return fail("Unknown compression type");
+  }
+
+  auto DataOps::decompress(Ref<Span<const u8>> data) -> Result<Vec<u8>>
+  {
+    const CompressionType type = detect_compression(data);
+    if (type == CompressionType::None)
+    {
+      return fail("Failed to inflate: Unrecognized compression format");
+    }
+    return decompress(type, data);
+  }
+
+  auto DataOps::decompress(const CompressionType type, Ref<Span<const u8>> data) -> Result<Vec<u8>>
+  {
+    switch (type)
+    {
+    case CompressionType::None:
+      return Vec<u8>(data.begin(), data.end());
+
+    case CompressionType::Gzip:
+      return gzip_inflate(data);
+
+    case CompressionType::Zlib:
+      return zlib_inflate(data);
+
+    case CompressionType::Zstd:
+      return zstd_inflate(data);
+
+    case CompressionType::Lz4:
+      return lz4_inflate(data);
+    }
+
+    return fail("Unknown compression type");
+  }
+
+  // zstd seekable format, see zstd/contrib/seekable_format/zstd_seekable_compression_format.md
+  constexpr const u32 ZSTD_SEEKABLE_SKIPPABLE_MAGIC = 0x184D2A5E; // ZSTD_MAGIC_SKIPPABLE_START | 0xE
+  constexpr const u32 ZSTD_SEEKABLE_MAGIC = 0x8F92EAB1;
+  constexpr const usize ZSTD_SEEKABLE_FOOTER_SIZE = 9;
+  constexpr const usize ZSTD_SEEKABLE_MAX_FRAMES = 0x8000000;
+  constexpr const usize ZSTD_SEEKABLE_MAX_FRAME_SIZE = 0x40000000;
+  constexpr const u8 ZSTD_SEEKABLE_CHECKSUM_FLAG = 0x80;
+
+  auto DataOps::zstd_seekable_deflate(Ref<Span<const u8>> data, Ref<CompressionOptions> options,
+                                      const usize frame_size) -> Result<Vec<u8>>
+  {
+    if (frame_size == 0 || frame_size > ZSTD_SEEKABLE_MAX_FRAME_SIZE)
+    {
+      return fail("Seekable frame size must be between 1 and {} bytes", ZSTD_SEEKABLE_MAX_FRAME_SIZE);
+    }
+
+    const usize frame_count = (data.size() + frame_size - 1) / frame_size;
+    if (frame_count > ZSTD_SEEKABLE_MAX_FRAMES)
+    {
+      return fail("Too many seekable frames ({}), use a larger frame size", frame_count);
+    }
+
+    const i32 level = options.level.value_or(ZSTD_CLEVEL_DEFAULT);
+    Mut<Vec<Vec<u8>>> frames(frame_count);
+    Mut<Vec<u32>> checksums(frame_count);
+    Mut<std::atomic<bool>> failed{false};
+
+    const usize task_count = std::min<usize>(std::max<u32>(options.workers, 1), frame_count);
+    const auto compress_frames = [&](const usize task_index) {
+      for (Mut<usize> i = task_index; i < frame_count && !failed.load(std::memory_order_relaxed); i += task_count)
+      {
+        const Span<const u8> chunk = data.subspan(i * frame_size, std::min(frame_size, data.size() - i * frame_size));
+        checksums[i] = static_cast<u32>(hash_xxhash64(chunk));
+
+        const Result<ZSTD_CCtx *> cctx = acquire_zstd_cctx();
+        if (!cctx)
+        {
+          failed = true;
+          return;
+        }
+
+        MutRef<Vec<u8>> frame = frames[i];
+        frame.resize(ZSTD_compressBound(chunk.size()));
+        const usize compressed_size =
+            ZSTD_compressCCtx(*cctx, frame.data(), frame.size(), chunk.data(), chunk.size(), level);
+        if (ZSTD_isError(compressed_size))
+        {
+          failed = true;
+          return;
+        }
+        frame.resize(compressed_size);
+      }
+    };
+    AU_TRY_PURE(run_on_workers(task_count, compress_frames));
+
+    if (failed)
+    {
+      return fail("Failed to deflate seekable frame");
+    }
+
+    const usize entry_size = 12;
+    const usize table_size = frame_count * entry_size + ZSTD_SEEKABLE_FOOTER_SIZE;
+
+    Mut<usize> total_size = 8 + table_size;
+    for (Ref<Vec<u8>> frame : frames)
+    {
+      total_size += frame.size();
     }
 
-    Mut<ZSTD_DCtx *> dctx = ZSTD_createDCtx();
     Mut<Vec<u8>> out_buffer;
-    out_buffer.resize(data.size() * 2);
+    out_buffer.reserve(total_size);
+    for (Ref<Vec<u8>> frame : frames)
+    {
+      out_buffer.insert(out_buffer.end(), frame.begin(), frame.end());
+    }
 
-    Mut<ZSTD_inBuffer> input = {data.data(), data.size(), 0};
-    Mut<ZSTD_outBuffer> output = {out_buffer.data(), out_buffer.size(), 0};
+    append_u32_le(out_buffer, ZSTD_SEEKABLE_SKIPPABLE_MAGIC);
+    append_u32_le(out_buffer, static_cast<u32>(table_size));
+    for (Mut<usize> i = 0; i < frame_count; ++i)
+    {
+      append_u32_le(out_buffer, static_cast<u32>(frames[i].size()));
+      append_u32_le(out_buffer, static_cast<u32>(std::min(frame_size, data.size() - i * frame_size)));
+      append_u32_le(out_buffer, checksums[i]);
+    }
+    append_u32_le(out_buffer, static_cast<u32>(frame_count));
+    out_buffer.push_back(ZSTD_SEEKABLE_CHECKSUM_FLAG);
+    append_u32_le(out_buffer, ZSTD_SEEKABLE_MAGIC);
 
-    Mut<usize> ret;
-    do
+    return out_buffer;
+  }
+
+  auto DataOps::ZstdSeekableReader::create(Ref<Span<const u8>> archive) -> Result<ZstdSeekableReader>
+  {
+    if (archive.size() < 8 + ZSTD_SEEKABLE_FOOTER_SIZE)
     {
-      ret = ZSTD_decompressStream(dctx, &output, &input);
+      return fail("Not a seekable zstd archive: too small");
+    }
 
-      if (ZSTD_isError(ret))
+    const u8 *footer = archive.data() + archive.size() - ZSTD_SEEKABLE_FOOTER_SIZE;
+    if (read_unaligned<u32>(footer + 5) != ZSTD_SEEKABLE_MAGIC)
+    {
+      return fail("Not a seekable zstd archive: missing seek table");
+    }
+
+    const u32 frame_count = read_unaligned<u32>(footer);
+    const u8 descriptor = footer[4];
+    if (descriptor & 0x7C)
+    {
+      return fail("Seekable zstd archive uses reserved descriptor bits");
+    }
+    if (frame_count > ZSTD_SEEKABLE_MAX_FRAMES)
+    {
+      return fail("Seekable zstd archive has too many frames ({})", frame_count);
+    }
+
+    const bool has_checksums = descriptor & ZSTD_SEEKABLE_CHECKSUM_FLAG;
+    const usize entry_size = has_checksums ? 12 : 8;
+    const usize table_size = static_cast<usize>(frame_count) * entry_size + ZSTD_SEEKABLE_FOOTER_SIZE;
+    if (archive.size() < table_size + 8)
+    {
+      return fail("Seekable zstd archive is truncated");
+    }
+
+    const usize table_start = archive.size() - table_size - 8;
+    if (read_unaligned<u32>(archive.data() + table_start) != ZSTD_SEEKABLE_SKIPPABLE_MAGIC ||
+        read_unaligned<u32>(archive.data() + table_start + 4) != table_size)
+    {
+      return fail("Seekable zstd archive has a corrupt seek table");
+    }
+
+    Mut<ZstdSeekableReader> reader;
+    reader.m_archive = archive;
+    reader.m_frames.reserve(frame_count);
+
+    Mut<u64> compressed_offset = 0;
+    Mut<u64> decompressed_offset = 0;
+    Mut<const u8 *> entry = archive.data() + table_start + 8;
+    for (Mut<u32> i = 0; i < frame_count; ++i, entry += entry_size)
+    {
+      Mut<Frame> frame;
+      frame.compressed_offset = compressed_offset;
+      frame.decompressed_offset = decompressed_offset;
+      frame.compressed_size = read_unaligned<u32>(entry);
+      frame.decompressed_size = read_unaligned<u32>(entry + 4);
+      if (has_checksums)
       {
-        ZSTD_freeDCtx(dctx);
-        return fail("Failed to inflate: {}", ZSTD_getErrorName(ret));
+        frame.checksum = read_unaligned<u32>(entry + 8);
       }
 
-      if (output.pos == output.size)
+      compressed_offset += frame.compressed_size;
+      decompressed_offset += frame.decompressed_size;
+      reader.m_frames.push_back(frame);
+    }
+
+    if (compressed_offset != table_start)
+    {
+      return fail("Seekable zstd archive seek table does not match its frames");
+    }
+
+    reader.m_decompressed_size = decompressed_offset;
+    return reader;
+  }
+
+  auto DataOps::ZstdSeekableReader::decompressed_size() const -> u64
+  {
+    return m_decompressed_size;
+  }
+
+  auto DataOps::ZstdSeekableReader::frames() const -> Span<const Frame>
+  {
+    return m_frames;
+  }
+
+  auto DataOps::ZstdSeekableReader::read(const u64 offset, Ref<Span<u8>> out, const u32 workers) const
+      -> Result<void>
+  {
+    if (offset > m_decompressed_size || out.size() > m_decompressed_size - offset)
+    {
+      return fail("Seekable read of {} bytes at {} is past the end ({} bytes)", out.size(), offset,
+                  m_decompressed_size);
+    }
+    if (out.empty())
+    {
+      return {};
+    }
+
+    const auto by_offset = [](const u64 value, Ref<Frame> frame) { return value < frame.decompressed_offset; };
+    const usize first =
+        static_cast<usize>(std::upper_bound(m_frames.begin(), m_frames.end(), offset, by_offset) - m_frames.begin()) -
+        1;
+    const usize last = static_cast<usize>(std::upper_bound(m_frames.begin(), m_frames.end(),
+                                                           offset + out.size() - 1, by_offset) -
+                                          m_frames.begin()) -
+                       1;
+    const usize frame_count = last - first + 1;
+
+    Mut<std::mutex> error_mutex;
+    Mut<Option<String>> error;
+    Mut<std::atomic<bool>> failed{false};
+
+    const auto report = [&](ForwardRef<String> message) {
+      const std::lock_guard<std::mutex> lock(error_mutex);
+      if (!error)
       {
-        const usize new_size = out_buffer.size() * 2;
-        out_buffer.resize(new_size);
-        output.dst = out_buffer.data();
-        output.size = new_size;
+        error = std::move(message);
       }
+      failed = true;
+    };
 
-    } while (ret != 0);
+    const usize task_count = std::min<usize>(std::max<u32>(workers, 1), frame_count);
+    const auto decode_frames = [&](const usize task_index) {
+      Mut<Vec<u8>> scratch;
+      for (Mut<usize> i = first + task_index; i <= last && !failed.load(std::memory_order_relaxed); i += task_count)
+      {
+        Ref<Frame> frame = m_frames[i];
+        const u64 frame_end = frame.decompressed_offset + frame.decompressed_size;
+        const bool whole_frame = frame.decompressed_offset >= offset && frame_end <= offset + out.size();
 
-    out_buffer.resize(output.pos);
-    ZSTD_freeDCtx(dctx);
+        Mut<Span<u8>> target;
+        if (whole_frame)
+        {
+          target = out.subspan(static_cast<usize>(frame.decompressed_offset - offset), frame.decompressed_size);
+        }
+        else
+        {
+          scratch.resize(frame.decompressed_size);
+          target = scratch;
+        }
+
+        const Span<const u8> source =
+            m_archive.subspan(static_cast<usize>(frame.compressed_offset), frame.compressed_size);
+        const Result<usize> decoded = zstd_inflate_into(source, target);
+        if (!decoded)
+        {
+          report(std::format("Seekable frame {}: {}", i, decoded.error()));
+          return;
+        }
+        if (*decoded != frame.decompressed_size)
+        {
+          report(std::format("Seekable frame {} decompressed to {} bytes, expected {}", i, *decoded,
+                             frame.decompressed_size));
+          return;
+        }
+        if (frame.checksum && static_cast<u32>(hash_xxhash64(Span<const u8>(target))) != *frame.checksum)
+        {
+          report(std::format("Seekable frame {} failed its checksum", i));
+          return;
+        }
+
+        if (!whole_frame)
+        {
+          const u64 copy_begin = std::max(offset, frame.decompressed_offset);
+          const u64 copy_end = std::min(offset + out.size(), frame_end);
+          std::memcpy(out.data() + (copy_begin - offset), scratch.data() + (copy_begin - frame.decompressed_offset),
+                      static_cast<usize>(copy_end - copy_begin));
+        }
+      }
+    };
+    const Result<void> ran = run_on_workers(task_count, decode_frames);
+    if (!ran)
+    {
+      return fail("Failed to inflate: {}", ran.error());
+    }
+
+    if (error)
+    {
+      return fail("Failed to inflate: {}", *error);
+    }
+    return {};
+  }
 
+  auto DataOps::ZstdSeekableReader::read_all(const u32 workers) const -> Result<Vec<u8>>
+  {
+    Mut<Vec<u8>> out_buffer;
+    out_buffer.resize(static_cast<usize>(m_decompressed_size));
+    AU_TRY_PURE(read(0, out_buffer, workers));
     return out_buffer;
   }
 
-  auto DataOps::zstd_deflate(Ref<Span<const u8>> data) -> Result<Vec<u8>>
+  // zlib counts input and output in uInt, larger spans are fed in slices of this size
+  constexpr const usize ZLIB_MAX_CHUNK = 1u << 30;
+  constexpr const usize ZLIB_STAGING_SIZE = 64 * 1024;
+
+  struct DataOps::StreamCompressor::Impl
   {
-    const usize max_dst_size = ZSTD_compressBound(data.size());
+    Mut<CompressionType> type{CompressionType::None};
+    Mut<z_stream> zs{};
+    Mut<ZSTD_CCtx *> cctx{};
+    Mut<Vec<u8>> staging;
 
-    Mut<Vec<u8>> out_buffer;
-    out_buffer.resize(max_dst_size);
+    ~Impl()
+    {
+      if (type == CompressionType::Zstd)
+      {
+        ZSTD_freeCCtx(cctx);
+      }
+      else
+      {
+        deflateEnd(&zs);
+      }
+    }
+
+    auto pump_zlib(Ref<Span<const u8>> data, const int flush, MutRef<StreamWriter> sink) -> Result<void>
+    {
+      Mut<usize> offset = 0;
+      do
+      {
+        const usize chunk = std::min(data.size() - offset, ZLIB_MAX_CHUNK);
+        const bool last_chunk = offset + chunk == data.size();
+        zs.next_in = const_cast<Bytef *>(data.data() + offset);
+        zs.avail_in = static_cast<uInt>(chunk);
+        offset += chunk;
+
+        const int chunk_flush = last_chunk ? flush : Z_NO_FLUSH;
+        Mut<int> ret;
+        do
+        {
+          zs.next_out = reinterpret_cast<Bytef *>(staging.data());
+          zs.avail_out = static_cast<uInt>(staging.size());
+
+          ret = deflate(&zs, chunk_flush);
+          if (ret == Z_STREAM_ERROR)
+          {
+            return fail("Failed to deflate: stream error");
+          }
+
+          const usize produced = staging.size() - zs.avail_out;
+          if (produced > 0)
+          {
+            AU_TRY_PURE(sink.write(staging.data(), produced));
+          }
+        } while (zs.avail_out == 0 || (chunk_flush == Z_FINISH && ret != Z_STREAM_END));
+      } while (offset < data.size());
+
+      return {};
+    }
 
-    const usize compressed_size = ZSTD_compress(out_buffer.data(), max_dst_size, data.data(), data.size(), 3);
+    auto pump_zstd(Ref<Span<const u8>> data, const ZSTD_EndDirective mode, MutRef<StreamWriter> sink)
+        -> Result<void>
+    {
+      Mut<ZSTD_inBuffer> input = {data.data(), data.size(), 0};
+      Mut<usize> remaining;
+      do
+      {
+        Mut<ZSTD_outBuffer> output = {staging.data(), staging.size(), 0};
+        remaining = ZSTD_compressStream2(cctx, &output, &input, mode);
+        if (ZSTD_isError(remaining))
+        {
+          return fail("Failed to deflate: {}", ZSTD_getErrorName(remaining));
+        }
 
-    if (ZSTD_isError(compressed_size))
+        if (output.pos > 0)
+        {
+          AU_TRY_PURE(sink.write(staging.data(), output.pos));
+        }
+      } while (mode == ZSTD_e_continue ? input.pos < input.size : remaining != 0);
+
+      return {};
+    }
+  };
+
+  auto DataOps::StreamCompressor::create(const CompressionType type, Ref<CompressionOptions> options)
+      -> Result<StreamCompressor>
+  {
+    Mut<Box<Impl>> impl = make_box<Impl>();
+
+    switch (type)
     {
-      return fail("Failed to deflate: {}", ZSTD_getErrorName(compressed_size));
+    case CompressionType::Gzip:
+    case CompressionType::Zlib: {
+      const int window_bits = type == CompressionType::Gzip ? 15 + 16 : 15;
+      const int level = options.level.value_or(Z_DEFAULT_COMPRESSION);
+      if (deflateInit2(&impl->zs, level, Z_DEFLATED, window_bits, 8, Z_DEFAULT_STRATEGY) != Z_OK)
+      {
+        return fail("Failed to initialize zlib deflate at level {}", level);
+      }
+      impl->staging.resize(ZLIB_STAGING_SIZE);
+      break;
     }
 
-    out_buffer.resize(compressed_size);
-    return out_buffer;
+    case CompressionType::Zstd:
+      impl->cctx = ZSTD_createCCtx();
+      if (!impl->cctx)
+      {
+        return fail("Failed to create ZSTD compression context");
+      }
+      ZSTD_CCtx_setParameter(impl->cctx, ZSTD_c_compressionLevel, options.level.value_or(ZSTD_CLEVEL_DEFAULT));
+      if (options.workers > 1)
+      {
+        // Ignored by builds of libzstd without ZSTD_MULTITHREAD
+        ZSTD_CCtx_setParameter(impl->cctx, ZSTD_c_nbWorkers, static_cast<int>(options.workers));
+      }
+      impl->staging.resize(ZSTD_CStreamOutSize());
+      break;
+
+    case CompressionType::Lz4:
+      return fail("StreamCompressor does not support LZ4, use lz4_deflate");
+
+    case CompressionType::None:
+      return fail("StreamCompressor needs a compression type");
+    }
+
+    impl->type = type;
+    return StreamCompressor(std::move(impl));
   }
 
-  auto DataOps::gzip_deflate(Ref<Span<const u8>> data) -> Result<Vec<u8>>
+  DataOps::StreamCompressor::StreamCompressor(Mut<Box<Impl>> impl) : m_impl(std::move(impl))
+  {
+  }
+
+  DataOps::StreamCompressor::StreamCompressor(ForwardRef<StreamCompressor> other) = default;
+  auto DataOps::StreamCompressor::operator=(ForwardRef<StreamCompressor> other) -> MutRef<StreamCompressor> = default;
+  DataOps::StreamCompressor::~StreamCompressor() = default;
+
+  auto DataOps::StreamCompressor::write(Ref<Span<const u8>> data, MutRef<StreamWriter> sink) -> Result<void>
+  {
+    if (data.empty())
+    {
+      return {};
+    }
+
+    if (m_impl->type == CompressionType::Zstd)
+    {
+      return m_impl->pump_zstd(data, ZSTD_e_continue, sink);
+    }
+    return m_impl->pump_zlib(data, Z_NO_FLUSH, sink);
+  }
+
+  auto DataOps::StreamCompressor::flush(MutRef<StreamWriter> sink) -> Result<void>
+  {
+    if (m_impl->type == CompressionType::Zstd)
+    {
+      return m_impl->pump_zstd({}, ZSTD_e_flush, sink);
+    }
+    return m_impl->pump_zlib({}, Z_SYNC_FLUSH, sink);
+  }
+
+  auto DataOps::StreamCompressor::finish(MutRef<StreamWriter> sink) -> Result<void>
+  {
+    if (m_impl->type == CompressionType::Zstd)
+    {
+      return m_impl->pump_zstd({}, ZSTD_e_end, sink);
+    }
+    return m_impl->pump_zlib({}, Z_FINISH, sink);
+  }
+
+  auto DataOps::StreamCompressor::reset() -> Result<void>
+  {
+    if (m_impl->type == CompressionType::Zstd)
+    {
+      const usize ret = ZSTD_CCtx_reset(m_impl->cctx, ZSTD_reset_session_only);
+      if (ZSTD_isError(ret))
+      {
+        return fail("Failed to reset ZSTD context: {}", ZSTD_getErrorName(ret));
+      }
+      return {};
+    }
+
+    if (deflateReset(&m_impl->zs) != Z_OK)
+    {
+      return fail("Failed to reset zlib deflate");
+    }
+    return {};
+  }
+
+  auto DataOps::StreamCompressor::type() const -> CompressionType
+  {
+    return m_impl->type;
+  }
+
+  struct DataOps::StreamDecompressor::Impl
   {
+    Mut<CompressionType> type{CompressionType::None};
     Mut<z_stream> zs{};
-    zs.zalloc = Z_NULL;
-    zs.zfree = Z_NULL;
-    zs.opaque = Z_NULL;
+    Mut<ZSTD_DCtx *> dctx{};
+    Mut<Vec<u8>> staging;
+    Mut<bool> at_boundary{true}; // No partially decoded stream/frame pending
 
-    if (deflateInit2(&zs, Z_DEFAULT_COMPRESSION, Z_DEFLATED, 15 + 16, 8, Z_DEFAULT_STRATEGY) != Z_OK)
+    ~Impl()
     {
-      return fail("Failed to initialize gzip deflate");
+      if (type == CompressionType::Zstd)
+      {
+        ZSTD_freeDCtx(dctx);
+      }
+      else
+      {
+        inflateEnd(&zs);
+      }
     }
 
-    zs.next_in = const_cast<Bytef *>(data.data());
-    zs.avail_in = static_cast<uInt>(data.size());
+    auto pump_zlib(Ref<Span<const u8>> data, MutRef<StreamWriter> sink) -> Result<void>
+    {
+      Mut<usize> offset = 0;
+      while (offset < data.size())
+      {
+        const usize chunk = std::min(data.size() - offset, ZLIB_MAX_CHUNK);
+        zs.next_in = const_cast<Bytef *>(data.data() + offset);
+        zs.avail_in = static_cast<uInt>(chunk);
+        offset += chunk;
+
+        // A full staging buffer may leave decoded bytes pending even once all input is consumed
+        do
+        {
+          zs.next_out = reinterpret_cast<Bytef *>(staging.data());
+          zs.avail_out = static_cast<uInt>(staging.size());
+
+          const int ret = inflate(&zs, Z_NO_FLUSH);
+          if (ret != Z_OK && ret != Z_STREAM_END && ret != Z_BUF_ERROR)
+          {
+            return fail("Failed to inflate: {}", zs.msg ? zs.msg : "corrupt data or stream error");
+          }
+
+          const usize produced = staging.size() - zs.avail_out;
+          if (produced > 0)
+          {
+            AU_TRY_PURE(sink.write(staging.data(), produced));
+          }
+
+          if (ret == Z_STREAM_END)
+          {
+            at_boundary = true;
+            if (inflateReset(&zs) != Z_OK)
+            {
+              return fail("Failed to reset zlib inflate");
+            }
+          }
+          else if (ret == Z_BUF_ERROR)
+          {
+            break;
+          }
+          else
+          {
+            at_boundary = false;
+          }
+        } while (zs.avail_in > 0 || zs.avail_out == 0);
+      }
 
-    Mut<Vec<u8>> out_buffer;
+      return {};
+    }
+
+    auto pump_zstd(Ref<Span<const u8>> data, MutRef<StreamWriter> sink) -> Result<void>
+    {
+      Mut<ZSTD_inBuffer> input = {data.data(), data.size(), 0};
+      Mut<ZSTD_outBuffer> output = {staging.data(), staging.size(), 0};
+      do
+      {
+        output.pos = 0;
+        const usize ret = ZSTD_decompressStream(dctx, &output, &input);
+        if (ZSTD_isError(ret))
+        {
+          return fail("Failed to inflate: {}", ZSTD_getErrorName(ret));
+        }
 
-    out_buffer.resize(deflateBound(&zs, static_cast<uLong>(data.size())) + 1024);
+        if (output.pos > 0)
+        {
+          AU_TRY_PURE(sink.write(staging.data(), output.pos));
+        }
+        at_boundary = ret == 0;
+      } while (input.pos < input.size || output.pos == output.size);
 
-    zs.next_out = reinterpret_cast<Bytef *>(out_buffer.data());
-    zs.avail_out = static_cast<uInt>(out_buffer.size());
+      return {};
+    }
+  };
 
-    const int ret = deflate(&zs, Z_FINISH);
+  auto DataOps::StreamDecompressor::create(const CompressionType type) -> Result<StreamDecompressor>
+  {
+    Mut<Box<Impl>> impl = make_box<Impl>();
 
-    if (ret != Z_STREAM_END)
+    switch (type)
     {
-      deflateEnd(&zs);
-      return fail("Failed to deflate");
+    case CompressionType::Gzip:
+    case CompressionType::Zlib:
+      // +32 lets zlib detect the gzip or zlib header itself
+      if (inflateInit2(&impl->zs, 15 + 32) != Z_OK)
+      {
+        return fail("Failed to initialize zlib inflate");
+      }
+      impl->staging.resize(ZLIB_STAGING_SIZE);
+      break;
+
+    case CompressionType::Zstd:
+      impl->dctx = ZSTD_createDCtx();
+      if (!impl->dctx)
+      {
+        return fail("Failed to create ZSTD decompression context");
+      }
+      impl->staging.resize(ZSTD_DStreamOutSize());
+      break;
+
+    case CompressionType::Lz4:
+      return fail("StreamDecompressor does not support LZ4, use lz4_inflate");
+
+    case CompressionType::None:
+      return fail("StreamDecompressor needs a compression type");
     }
 
-    out_buffer.resize(zs.total_out);
+    impl->type = type;
+    return StreamDecompressor(std::move(impl));
+  }
 
-    deflateEnd(&zs);
-    return out_buffer;
+  DataOps::StreamDecompressor::StreamDecompressor(Mut<Box<Impl>> impl) : m_impl(std::move(impl))
+  {
   }
 
-  auto DataOps::gzip_inflate(Ref<Span<const u8>> data) -> Result<Vec<u8>>
+  DataOps::StreamDecompressor::StreamDecompressor(ForwardRef<StreamDecompressor> other) = default;
+  auto DataOps::StreamDecompressor::operator=(ForwardRef<StreamDecompressor> other)
+      -> MutRef<StreamDecompressor> = default;
+  DataOps::StreamDecompressor::~StreamDecompressor() = default;
+
+  auto DataOps::StreamDecompressor::write(Ref<Span<const u8>> data, MutRef<StreamWriter> sink) -> Result<void>
   {
-    return zlib_inflate(data);
+    if (data.empty())
+    {
+      return {};
+    }
+
+    if (m_impl->type == CompressionType::Zstd)
+    {
+      return m_impl->pump_zstd(data, sink);
+    }
+    return m_impl->pump_zlib(data, sink);
+  }
+
+  auto DataOps::StreamDecompressor::finish() -> Result<void>
+  {
+    if (!m_impl->at_boundary)
+    {
+      return fail("Failed to inflate: stream is truncated");
+    }
+    return {};
+  }
+
+  auto DataOps::StreamDecompressor::reset() -> Result<void>
+  {
+    m_impl->at_boundary = true;
+
+    if (m_impl->type == CompressionType::Zstd)
+    {
+      const usize ret = ZSTD_DCtx_reset(m_impl->dctx, ZSTD_reset_session_only);
+      if (ZSTD_isError(ret))
+      {
+        return fail("Failed to reset ZSTD context: {}", ZSTD_getErrorName(ret));
+      }
+      return {};
+    }
+
+    if (inflateReset(&m_impl->zs) != Z_OK)
+    {
+      return fail("Failed to reset zlib inflate");
+    }
+    return {};
+  }
+
+  auto DataOps::StreamDecompressor::type() const -> CompressionType
+  {
+    return m_impl->type;
   }
 
 } // namespace IACore
\ No newline at end of file
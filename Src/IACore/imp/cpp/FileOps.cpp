@@ -13,50 +13,87 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <IACore/AsyncOps.hpp>
 #include <IACore/FileOps.hpp>
 #include <cerrno>
 #include <cstdio>
+#include <deque>
 
 #if IA_PLATFORM_UNIX
 #  include <fcntl.h>
+#  include <limits.h>
 #  include <sys/mman.h>
 #  include <sys/stat.h>
+#  include <sys/uio.h>
 #  include <unistd.h>
 #endif
 
+#if IA_PLATFORM_LINUX
+#  include <linux/fs.h>
+#  include <linux/io_uring.h>
+#  include <sys/ioctl.h>
+#  include <sys/sendfile.h>
+#  include <sys/syscall.h>
+#endif
+
+#if IA_PLATFORM_APPLE
+#  include <copyfile.h>
+#endif
+
 namespace IACore
 {
 
-  Mut<HashMap<const u8 *, std::tuple<void *, void *, void *>>> FileOps::s_mapped_files;
+  Mut<FileOps::MappedFileRegistry> FileOps::s_mapped_files;
 
-  auto FileOps::unmap_file(const u8 *mapped_ptr) -> void
+  auto FileOps::MappedFileRegistry::shard_for(const u8 *address) -> MutRef<Shard>
+  {
+    // Mappings are page aligned, so mix in the bits above the page offset
+    const u64 page = static_cast<u64>(reinterpret_cast<uintptr_t>(address)) >> 12;
+    return m_shards[(page * 0x9E3779B97F4A7C15ull) >> 60];
+  }
+
+  auto FileOps::MappedFileRegistry::insert(const u8 *address, Ref<MappedFile> file) -> void
   {
-    if (!s_mapped_files.contains(mapped_ptr))
+    MutRef<Shard> shard = shard_for(address);
+    const std::lock_guard<std::mutex> lock(shard.mutex);
+    shard.files[address] = file;
+  }
+
+  auto FileOps::MappedFileRegistry::take(const u8 *address) -> Option<MappedFile>
+  {
+    MutRef<Shard> shard = shard_for(address);
+    const std::lock_guard<std::mutex> lock(shard.mutex);
+
+    const auto it = shard.files.find(address);
+    if (it == shard.files.end())
     {
-      return;
+      return std::nullopt;
     }
 
-    Mut<decltype(s_mapped_files)::iterator> it = s_mapped_files.find(mapped_ptr);
-    const std::tuple<void *, void *, void *> handles = it->second;
-    s_mapped_files.erase(it);
-
-#if IA_PLATFORM_WINDOWS
-    ::UnmapViewOfFile(std::get<1>(handles));
-    ::CloseHandle(static_cast<HANDLE>(std::get<2>(handles)));
+    const MappedFile file = it->second;
+    shard.files.erase(it);
+    return file;
+  }
 
-    const HANDLE handle = static_cast<HANDLE>(std::get<0>(handles));
-    if (handle != INVALID_HANDLE_VALUE)
+  auto FileOps::unmap_file(const u8 *mapped_ptr) -> void
+  {
+    const Option<MappedFile> file = s_mapped_files.take(mapped_ptr);
+    if (!file)
     {
-      ::CloseHandle(handle);
+      return;
     }
+
+#if IA_PLATFORM_WINDOWS
+    ::UnmapViewOfFile(file->address);
+    ::CloseHandle(file->mapping_handle);
 #elif IA_PLATFORM_UNIX
-    ::munmap(std::get<1>(handles), (usize) std::get<2>(handles));
-    const i32 fd = (i32) ((u64) std::get<0>(handles));
-    if (fd != -1)
+    ::munmap(file->address, file->size);
+#endif
+
+    if (file->file_handle != INVALID_FILE_HANDLE)
     {
-      ::close(fd);
+      native_close_file(file->file_handle);
     }
-#endif
   }
 
   auto FileOps::map_shared_memory(Ref<String> name, const usize size, const bool is_owner) -> Result<u8 *>
@@ -89,7 +126,10 @@ namespace IACore
       return fail("Failed to map view of shared memory '{}'", name);
     }
 
-    s_mapped_files[result] = std::make_tuple((void *) INVALID_HANDLE_VALUE, (void *) result, (void *) h_map);
+    s_mapped_files.insert(result, {.file_handle = INVALID_FILE_HANDLE,
+                                   .address = result,
+                                   .size = size,
+                                   .mapping_handle = h_map});
     return result;
 
 #elif IA_PLATFORM_UNIX
@@ -126,7 +166,7 @@ namespace IACore
 
     Mut<u8 *> result = static_cast<u8 *>(addr);
 
-    s_mapped_files[result] = std::make_tuple((void *) ((u64) fd), (void *) addr, (void *) size);
+    s_mapped_files.insert(result, {.file_handle = fd, .address = addr, .size = size});
     return result;
 #endif
   }
@@ -180,7 +220,10 @@ namespace IACore
       CloseHandle(h_map);
       return fail("Failed to memory map {}", path.string());
     }
-    s_mapped_files[result] = std::make_tuple((void *) handle, (void *) const_cast<u8 *>(result), (void *) h_map);
+    s_mapped_files.insert(result, {.file_handle = handle,
+                                   .address = const_cast<u8 *>(result),
+                                   .size = size,
+                                   .mapping_handle = h_map});
     return result;
 
 #elif IA_PLATFORM_UNIX
@@ -209,7 +252,7 @@ namespace IACore
     }
     const u8 *result = static_cast<const u8 *>(addr);
     madvise(addr, size, MADV_SEQUENTIAL);
-    s_mapped_files[result] = std::make_tuple((void *) ((u64) handle), (void *) addr, (void *) size);
+    s_mapped_files.insert(result, {.file_handle = handle, .address = addr, .size = size});
     return result;
 #endif
   }
@@ -273,6 +316,91 @@ namespace IACore
     return result;
   }
 
+  auto FileOps::read_binary_files(const Span<const Path> paths) -> Vec<Result<Vec<u8>>>
+  {
+    Mut<Vec<Result<Vec<u8>>>> results;
+    results.reserve(paths.size());
+    for (Mut<usize> i = 0; i < paths.size(); ++i)
+    {
+      results.push_back(Vec<u8>{});
+    }
+
+    Mut<Result<AsyncIo>> io = AsyncIo::create();
+    if (!io)
+    {
+      for (MutRef<Result<Vec<u8>>> result : results)
+      {
+        result = fail("{}", io.error());
+      }
+      return results;
+    }
+
+    Mut<Vec<NativeFileHandle>> handles(paths.size(), INVALID_FILE_HANDLE);
+
+    // Queues the rest of file `index` after `done` bytes; a short read means the file shrank
+    Mut<std::function<void(const usize, const usize)>> read_from;
+    read_from = [&](const usize index, const usize done) {
+      MutRef<Vec<u8>> data = *results[index];
+      const usize chunk = std::min(data.size() - done, AsyncIo::MAX_REQUEST_SIZE);
+      const Result<void> queued = io->read(handles[index], done, Span<u8>(data.data() + done, chunk),
+                                           [&, index, done, chunk](Result<usize> result) {
+                                             if (!result)
+                                             {
+                                               results[index] = fail("Failed to read file {}: {}",
+                                                                     paths[index].string(), result.error());
+                                             }
+                                             else if (*result == chunk && done + chunk < results[index]->size())
+                                             {
+                                               read_from(index, done + chunk);
+                                             }
+                                             else
+                                             {
+                                               results[index]->resize(done + *result);
+                                             }
+                                           });
+      if (!queued)
+      {
+        results[index] = fail("{}", queued.error());
+      }
+    };
+
+    for (Mut<usize> i = 0; i < paths.size(); ++i)
+    {
+      const Result<NativeFileHandle> handle = native_open_file(paths[i], FileAccess::Read, FileMode::OpenExisting);
+      if (!handle)
+      {
+        results[i] = fail("{}", handle.error());
+        continue;
+      }
+      handles[i] = *handle;
+
+      Mut<std::error_code> ec;
+      const uintmax_t size = std::filesystem::file_size(paths[i], ec);
+      if (ec)
+      {
+        results[i] = fail("Failed to get size of {}: {}", paths[i].string(), ec.message());
+        continue;
+      }
+      if (size > 0)
+      {
+        results[i]->resize(static_cast<usize>(size));
+        read_from(i, 0);
+      }
+    }
+
+    const Result<void> drained = io->drain();
+    for (Mut<usize> i = 0; i < paths.size(); ++i)
+    {
+      native_close_file(handles[i]);
+      if (!drained && results[i])
+      {
+        results[i] = fail("{}", drained.error());
+      }
+    }
+
+    return results;
+  }
+
   auto FileOps::write_text_file(Ref<Path> path, Ref<String> contents, const bool overwrite) -> Result<usize>
   {
     const char *mode = overwrite ? "w" : "wx";
@@ -307,6 +435,443 @@ namespace IACore
     return result;
   }
 
+  auto FileOps::write_vectored(const NativeFileHandle handle, const Span<const Span<const u8>> buffers)
+      -> Result<usize>
+  {
+    Mut<usize> total = 0;
+
+#if IA_PLATFORM_WINDOWS
+    for (Ref<Span<const u8>> buffer : buffers)
+    {
+      Mut<usize> done = 0;
+      while (done < buffer.size())
+      {
+        const DWORD chunk = static_cast<DWORD>(std::min<usize>(buffer.size() - done, 0x40000000));
+        Mut<DWORD> written = 0;
+        if (!WriteFile(handle, buffer.data() + done, chunk, &written, NULL))
+        {
+          return fail("Failed to write to file: {}", GetLastError());
+        }
+        done += written;
+      }
+      total += done;
+    }
+#else
+    Mut<Vec<iovec>> iovecs;
+    iovecs.reserve(buffers.size());
+    for (Ref<Span<const u8>> buffer : buffers)
+    {
+      if (!buffer.empty())
+      {
+        iovecs.push_back({const_cast<u8 *>(buffer.data()), buffer.size()});
+      }
+    }
+
+    Mut<usize> first = 0;
+    while (first < iovecs.size())
+    {
+      const int count = static_cast<int>(std::min<usize>(iovecs.size() - first, IOV_MAX));
+      const ssize_t written = ::writev(handle, &iovecs[first], count);
+      if (written < 0)
+      {
+        if (errno == EINTR)
+        {
+          continue;
+        }
+        return fail("Failed to write to file: {}", errno);
+      }
+      total += static_cast<usize>(written);
+
+      // Skip what went out, a short write resumes mid-buffer
+      Mut<usize> consumed = static_cast<usize>(written);
+      while (first < iovecs.size() && consumed >= iovecs[first].iov_len)
+      {
+        consumed -= iovecs[first].iov_len;
+        ++first;
+      }
+      if (consumed > 0)
+      {
+        iovecs[first].iov_base = static_cast<u8 *>(iovecs[first].iov_base) + consumed;
+        iovecs[first].iov_len -= consumed;
+      }
+    }
+#endif
+
+    return total;
+  }
+
+  auto FileOps::write_vectored(Ref<Path> path, const Span<const Span<const u8>> buffers, const bool overwrite)
+      -> Result<usize>
+  {
+    const NativeFileHandle handle =
+        AU_TRY(native_open_file(path, FileAccess::Write, overwrite ? FileMode::CreateAlways : FileMode::CreateNew));
+
+    const Result<usize> result = write_vectored(handle, buffers);
+    native_close_file(handle);
+    return result;
+  }
+
+#if !IA_PLATFORM_WINDOWS
+  // Plain read/write loop for when the kernel can't copy between the two files itself
+  static auto copy_through_buffer(const int source, const int destination) -> Result<usize>
+  {
+    Mut<Vec<u8>> buffer(256 * 1024);
+    Mut<usize> total = 0;
+    while (true)
+    {
+      const ssize_t read_count = ::read(source, buffer.data(), buffer.size());
+      if (read_count < 0)
+      {
+        if (errno == EINTR)
+        {
+          continue;
+        }
+        return fail("Failed to read source file: {}", errno);
+      }
+      if (read_count == 0)
+      {
+        return total;
+      }
+
+      const Span<const u8> chunk(buffer.data(), static_cast<usize>(read_count));
+      total += AU_TRY(FileOps::write_vectored(destination, Span<const Span<const u8>>(&chunk, 1)));
+    }
+  }
+#endif
+
+#if IA_PLATFORM_LINUX
+  // Reflink, then copy_file_range, then sendfile; each falls through where the filesystem or kernel lacks it
+  static auto copy_in_kernel(const int source, const int destination, const usize size) -> Result<usize>
+  {
+    if (size > 0 && ::ioctl(destination, FICLONE, source) == 0)
+    {
+      return size;
+    }
+
+    // Runs until end of file rather than to `size`, in case the source grew meanwhile
+    constexpr const usize CHUNK = 0x40000000;
+
+    Mut<usize> total = 0;
+    Mut<bool> use_copy_file_range = true;
+    while (true)
+    {
+      const ssize_t copied = use_copy_file_range ? ::copy_file_range(source, nullptr, destination, nullptr, CHUNK, 0)
+                                                 : ::sendfile(destination, source, nullptr, CHUNK);
+      if (copied < 0)
+      {
+        if (errno == EINTR)
+        {
+          continue;
+        }
+        if (total == 0 && (errno == EXDEV || errno == ENOSYS || errno == EINVAL || errno == EOPNOTSUPP))
+        {
+          if (use_copy_file_range)
+          {
+            use_copy_file_range = false;
+            continue;
+          }
+          return copy_through_buffer(source, destination);
+        }
+        return fail("Failed to copy file data: {}", errno);
+      }
+      if (copied == 0)
+      {
+        return total;
+      }
+      total += static_cast<usize>(copied);
+    }
+  }
+#endif
+
+  auto FileOps::copy_file(Ref<Path> from, Ref<Path> to, const bool overwrite) -> Result<usize>
+  {
+    Mut<std::error_code> ec;
+    const uintmax_t size = std::filesystem::file_size(from, ec);
+    if (ec)
+    {
+      return fail("Failed to get size of {}: {}", from.string(), ec.message());
+    }
+
+#if IA_PLATFORM_WINDOWS
+    // Block-clones on ReFS, otherwise copies without leaving the kernel
+    if (!CopyFileW(from.wstring().c_str(), to.wstring().c_str(), overwrite ? FALSE : TRUE))
+    {
+      const DWORD error = GetLastError();
+      if (error == ERROR_FILE_EXISTS)
+      {
+        return fail("File already exists: {}", to.string());
+      }
+      return fail("Failed to copy {} to {}: {}", from.string(), to.string(), error);
+    }
+    return static_cast<usize>(size);
+#elif IA_PLATFORM_APPLE
+    if (std::filesystem::equivalent(from, to, ec))
+    {
+      return fail("Cannot copy {} onto itself", from.string());
+    }
+
+    // Clones on APFS, otherwise copies in the kernel
+    const copyfile_flags_t flags = COPYFILE_CLONE | COPYFILE_DATA | COPYFILE_STAT | (overwrite ? 0 : COPYFILE_EXCL);
+    if (copyfile(from.string().c_str(), to.string().c_str(), nullptr, flags) != 0)
+    {
+      if (errno == EEXIST)
+      {
+        return fail("File already exists: {}", to.string());
+      }
+      return fail("Failed to copy {} to {}: {}", from.string(), to.string(), errno);
+    }
+    return static_cast<usize>(size);
+#else
+    const NativeFileHandle source = AU_TRY(native_open_file(from, FileAccess::Read, FileMode::OpenExisting));
+
+    Mut<struct stat> source_stat;
+    if (fstat(source, &source_stat) != 0)
+    {
+      native_close_file(source);
+      return fail("Failed to stat {}: {}", from.string(), errno);
+    }
+
+    // Not truncated on open: `to` may be `from` itself, a hard link or a symlink to it
+    const Result<NativeFileHandle> destination =
+        native_open_file(to, FileAccess::Write, overwrite ? FileMode::OpenAlways : FileMode::CreateNew,
+                         source_stat.st_mode & 0777);
+    if (!destination)
+    {
+      native_close_file(source);
+      if (!overwrite && std::filesystem::exists(to))
+      {
+        return fail("File already exists: {}", to.string());
+      }
+      return fail("{}", destination.error());
+    }
+
+    Mut<Result<usize>> result = usize{0};
+    Mut<struct stat> destination_stat;
+    if (fstat(*destination, &destination_stat) != 0)
+    {
+      result = fail("Failed to stat {}: {}", to.string(), errno);
+    }
+    else if (destination_stat.st_dev == source_stat.st_dev && destination_stat.st_ino == source_stat.st_ino)
+    {
+      native_close_file(*destination);
+      native_close_file(source);
+      return fail("Cannot copy {} onto itself", from.string());
+    }
+    else if (ftruncate(*destination, 0) != 0)
+    {
+      result = fail("Failed to truncate {}: {}", to.string(), errno);
+    }
+    else
+    {
+#  if IA_PLATFORM_LINUX
+      result = copy_in_kernel(source, *destination, static_cast<usize>(size));
+#  else
+      result = copy_through_buffer(source, *destination);
+#  endif
+    }
+
+    native_close_file(*destination);
+    native_close_file(source);
+
+    // Don't leave a partial copy behind
+    if (!result)
+    {
+      std::filesystem::remove(to, ec);
+    }
+    return result;
+#endif
+  }
+
+  // Flushes file data (and the metadata needed to read it back) to stable storage
+  static auto sync_file(const NativeFileHandle handle) -> Result<void>
+  {
+#if IA_PLATFORM_WINDOWS
+    if (!FlushFileBuffers(handle))
+    {
+      return fail("Failed to flush file: {}", GetLastError());
+    }
+#elif IA_PLATFORM_APPLE
+    // Plain fsync leaves the data in the drive's cache on Apple platforms
+    if (fcntl(handle, F_FULLFSYNC) == -1 && fsync(handle) == -1)
+    {
+      return fail("Failed to flush file: {}", errno);
+    }
+#else
+    if (fdatasync(handle) == -1)
+    {
+      return fail("Failed to flush file: {}", errno);
+    }
+#endif
+    return {};
+  }
+
+  // Makes renames into `directory` durable. Windows has no equivalent, renames there are flushed
+  // with the file system journal.
+  static auto sync_directory(Ref<Path> directory) -> Result<void>
+  {
+#if IA_PLATFORM_UNIX
+    const int fd = ::open(directory.empty() ? "." : directory.string().c_str(), O_RDONLY | O_DIRECTORY);
+    if (fd == -1)
+    {
+      return fail("Failed to open directory {}: {}", directory.string(), errno);
+    }
+    const int result = fsync(fd);
+    ::close(fd);
+    if (result == -1)
+    {
+      return fail("Failed to sync directory {}: {}", directory.string(), errno);
+    }
+#else
+    AU_UNUSED(directory);
+#endif
+    return {};
+  }
+
+  // A name in the same directory (so the rename stays on one file system) no other writer picks
+  static auto make_temp_path(Ref<Path> target) -> Path
+  {
+    static Mut<std::atomic<u64>> s_counter{0};
+
+#if IA_PLATFORM_WINDOWS
+    const u64 process_id = GetCurrentProcessId();
+#else
+    const u64 process_id = static_cast<u64>(getpid());
+#endif
+
+    Mut<Path> temp = target;
+    temp.replace_filename(std::format(".{}.{}.{}.tmp", target.filename().string(), process_id,
+                                      s_counter.fetch_add(1, std::memory_order_relaxed)));
+    return temp;
+  }
+
+  auto FileOps::write_file_atomic(Ref<Path> path, const Span<const u8> contents) -> Result<void>
+  {
+    Mut<AtomicWriteBatch> batch;
+    AU_TRY_PURE(batch.add(path, contents));
+    return batch.commit();
+  }
+
+  FileOps::AtomicWriteBatch::~AtomicWriteBatch()
+  {
+    discard();
+  }
+
+  auto FileOps::AtomicWriteBatch::operator=(ForwardRef<AtomicWriteBatch> other) -> MutRef<AtomicWriteBatch>
+  {
+    if (this != &other)
+    {
+      discard();
+      m_entries = std::move(other.m_entries);
+      other.m_entries.clear();
+    }
+    return *this;
+  }
+
+  auto FileOps::AtomicWriteBatch::add(Ref<Path> path, const Span<const u8> contents) -> Result<void>
+  {
+    Mut<Entry> entry{.target = path, .temp = make_temp_path(path), .handle = INVALID_FILE_HANDLE};
+
+    // Keep the permissions of the file being replaced
+    Mut<Option<u32>> kept_permissions;
+#if IA_PLATFORM_UNIX
+    Mut<struct stat> sb;
+    if (stat(path.string().c_str(), &sb) == 0)
+    {
+      kept_permissions = sb.st_mode & 07777;
+    }
+#endif
+
+    entry.handle = AU_TRY(
+        native_open_file(entry.temp, FileAccess::Write, FileMode::CreateNew, kept_permissions.value_or(0644)));
+
+    Mut<Result<usize>> written = usize{0};
+#if IA_PLATFORM_UNIX
+    // open() applies the umask, which would turn a 0664 file into 0644
+    if (kept_permissions && fchmod(entry.handle, *kept_permissions) != 0)
+    {
+      written = fail("Failed to set permissions: {}", errno);
+    }
+#endif
+    if (written)
+    {
+      written = write_vectored(entry.handle, Span<const Span<const u8>>(&contents, 1));
+    }
+    if (!written)
+    {
+      native_close_file(entry.handle);
+      Mut<std::error_code> ec;
+      std::filesystem::remove(entry.temp, ec);
+      return fail("Failed to stage {}: {}", path.string(), written.error());
+    }
+
+#if IA_PLATFORM_LINUX
+    // Starts writeback without waiting, so the flushes in commit() mostly find the work done
+    sync_file_range(entry.handle, 0, 0, SYNC_FILE_RANGE_WRITE);
+#endif
+
+    m_entries.push_back(std::move(entry));
+    return {};
+  }
+
+  auto FileOps::AtomicWriteBatch::commit() -> Result<void>
+  {
+    for (MutRef<Entry> entry : m_entries)
+    {
+      if (entry.handle == INVALID_FILE_HANDLE)
+      {
+        continue;
+      }
+      AU_TRY_PURE(sync_file(entry.handle));
+      native_close_file(entry.handle);
+      entry.handle = INVALID_FILE_HANDLE;
+    }
+
+    Mut<Vec<Path>> directories;
+    while (!m_entries.empty())
+    {
+      Ref<Entry> entry = m_entries.back();
+
+      Mut<std::error_code> ec;
+      std::filesystem::rename(entry.temp, entry.target, ec);
+      if (ec)
+      {
+        // Still make the entries already moved into place durable
+        for (Ref<Path> directory : directories)
+        {
+          AU_UNUSED(sync_directory(directory));
+        }
+        return fail("Failed to move {} into place: {}", entry.target.string(), ec.message());
+      }
+
+      Mut<Path> directory = entry.target.parent_path();
+      if (std::find(directories.begin(), directories.end(), directory) == directories.end())
+      {
+        directories.push_back(std::move(directory));
+      }
+      m_entries.pop_back();
+    }
+
+    for (Ref<Path> directory : directories)
+    {
+      AU_TRY_PURE(sync_directory(directory));
+    }
+    return {};
+  }
+
+  auto FileOps::AtomicWriteBatch::discard() -> void
+  {
+    for (Ref<Entry> entry : m_entries)
+    {
+      if (entry.handle != INVALID_FILE_HANDLE)
+      {
+        native_close_file(entry.handle);
+      }
+      Mut<std::error_code> ec;
+      std::filesystem::remove(entry.temp, ec);
+    }
+    m_entries.clear();
+  }
+
   auto FileOps::normalize_executable_path(Ref<Path> path) -> Path
   {
     Mut<Path> result = path;
@@ -334,8 +899,8 @@ namespace IACore
     return result;
   }
 
-  auto FileOps::native_open_file(Ref<Path> path, const FileAccess access, const FileMode mode, const u32 permissions)
-      -> Result<NativeFileHandle>
+  auto FileOps::native_open_file(Ref<Path> path, const FileAccess access, const FileMode mode, const u32 permissions,
+                                 const bool direct_io) -> Result<NativeFileHandle>
   {
 #if IA_PLATFORM_WINDOWS
     AU_UNUSED(permissions);
@@ -344,6 +909,10 @@ namespace IACore
     Mut<DWORD> dw_share = FILE_SHARE_READ;
     Mut<DWORD> dw_disposition = 0;
     Mut<DWORD> dw_flags_and_attributes = FILE_ATTRIBUTE_NORMAL;
+    if (direct_io)
+    {
+      dw_flags_and_attributes |= FILE_FLAG_NO_BUFFERING | FILE_FLAG_WRITE_THROUGH;
+    }
 
     switch (access)
     {
@@ -421,6 +990,13 @@ namespace IACore
       break;
     }
 
+#  if defined(O_DIRECT)
+    if (direct_io)
+    {
+      flags |= O_DIRECT;
+    }
+#  endif
+
     Mut<int> fd = open(path.string().c_str(), flags, permissions);
 
     if (fd == -1)
@@ -428,6 +1004,13 @@ namespace IACore
       return fail("Failed to open file '{}': {}", path.string(), errno);
     }
 
+#  if IA_PLATFORM_APPLE
+    if (direct_io)
+    {
+      fcntl(fd, F_NOCACHE, 1);
+    }
+#  endif
+
     return fd;
 #endif
   }
@@ -474,8 +1057,19 @@ namespace IACore
     return *this;
   }
 
-  auto FileOps::MemoryMappedRegion::map(const NativeFileHandle handle, const u64 offset, const usize size)
-      -> Result<void>
+  auto FileOps::MemoryMappedRegion::offset_alignment() -> usize
+  {
+#if IA_PLATFORM_WINDOWS
+    Mut<SYSTEM_INFO> info;
+    GetSystemInfo(&info);
+    return info.dwAllocationGranularity;
+#else
+    return static_cast<usize>(sysconf(_SC_PAGESIZE));
+#endif
+  }
+
+  auto FileOps::MemoryMappedRegion::map(const NativeFileHandle handle, const u64 offset, const usize size,
+                                        const bool read_only) -> Result<void>
   {
     unmap();
 
@@ -499,6 +1093,11 @@ namespace IACore
     const u64 end_offset = offset + size;
     if (static_cast<u64>(file_size.QuadPart) < end_offset)
     {
+      if (read_only)
+      {
+        return fail("Cannot map past the end of the file read-only (Offset: {}, Size: {})", offset, size);
+      }
+
       Mut<LARGE_INTEGER> new_size;
       new_size.QuadPart = static_cast<LONGLONG>(end_offset);
       if (!SetFilePointerEx(handle, new_size, NULL, FILE_BEGIN))
@@ -512,7 +1111,7 @@ namespace IACore
       }
     }
 
-    m_map_handle = CreateFileMappingW(handle, NULL, PAGE_READWRITE, 0, 0, NULL);
+    m_map_handle = CreateFileMappingW(handle, NULL, read_only ? PAGE_READONLY : PAGE_READWRITE, 0, 0, NULL);
     if (m_map_handle == NULL)
     {
       return fail("CreateFileMapping failed: {}", GetLastError());
@@ -521,7 +1120,8 @@ namespace IACore
     const DWORD offset_high = static_cast<DWORD>(offset >> 32);
     const DWORD offset_low = static_cast<DWORD>(offset & 0xFFFFFFFF);
 
-    m_ptr = static_cast<u8 *>(MapViewOfFile(m_map_handle, FILE_MAP_WRITE, offset_high, offset_low, size));
+    m_ptr = static_cast<u8 *>(
+        MapViewOfFile(m_map_handle, read_only ? FILE_MAP_READ : FILE_MAP_WRITE, offset_high, offset_low, size));
     if (m_ptr == NULL)
     {
       CloseHandle(m_map_handle);
@@ -540,13 +1140,19 @@ namespace IACore
     const u64 end_offset = offset + size;
     if (static_cast<u64>(sb.st_size) < end_offset)
     {
+      if (read_only)
+      {
+        return fail("Cannot map past the end of the file read-only (Offset: {}, Size: {})", offset, size);
+      }
+
       if (ftruncate(handle, static_cast<off_t>(end_offset)) == -1)
       {
         return fail("Failed to ftruncate (extend) file");
       }
     }
 
-    Mut<void *> ptr = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, handle, static_cast<off_t>(offset));
+    const int protection = read_only ? PROT_READ : PROT_READ | PROT_WRITE;
+    Mut<void *> ptr = mmap(nullptr, size, protection, MAP_SHARED, handle, static_cast<off_t>(offset));
     if (ptr == MAP_FAILED)
     {
       return fail("mmap failed: {}", errno);
@@ -596,4 +1202,596 @@ namespace IACore
 #endif
   }
 
-} // namespace IACore
\ No newline at end of file
+  // Full positional transfer for the thread pool backend. Returns bytes moved or a negative error code.
+  static auto blocking_transfer(const NativeFileHandle handle, const u64 offset, Mut<u8 *> data, const usize size,
+                                const bool is_write) -> i64
+  {
+    Mut<usize> done = 0;
+    while (done < size)
+    {
+#if IA_PLATFORM_WINDOWS
+      Mut<OVERLAPPED> overlapped{};
+      overlapped.Offset = static_cast<DWORD>((offset + done) & 0xFFFFFFFF);
+      overlapped.OffsetHigh = static_cast<DWORD>((offset + done) >> 32);
+
+      const DWORD chunk = static_cast<DWORD>(std::min<usize>(size - done, 0x40000000));
+      Mut<DWORD> moved = 0;
+      const BOOL ok = is_write ? WriteFile(handle, data + done, chunk, &moved, &overlapped)
+                               : ReadFile(handle, data + done, chunk, &moved, &overlapped);
+      if (!ok)
+      {
+        const DWORD error = GetLastError();
+        if (error == ERROR_HANDLE_EOF)
+        {
+          break;
+        }
+        return -static_cast<i64>(error);
+      }
+#else
+      const ssize_t moved = is_write ? ::pwrite(handle, data + done, size - done, static_cast<off_t>(offset + done))
+                                     : ::pread(handle, data + done, size - done, static_cast<off_t>(offset + done));
+      if (moved < 0)
+      {
+        if (errno == EINTR)
+        {
+          continue;
+        }
+        return -static_cast<i64>(errno);
+      }
+#endif
+      if (moved == 0)
+      {
+        break;
+      }
+      done += static_cast<usize>(moved);
+    }
+    return static_cast<i64>(done);
+  }
+
+  struct FileOps::AsyncIo::Impl
+  {
+    struct Request
+    {
+      Mut<NativeFileHandle> handle{INVALID_FILE_HANDLE};
+      Mut<u64> offset{};
+      Mut<u8 *> data{};
+      Mut<u32> size{};
+      Mut<bool> is_write{false};
+      Mut<Option<u32>> buffer_index{};
+      Mut<CompletionCallback> on_complete{};
+      Mut<u32> done{}; // Bytes moved by earlier short transfers, the rest is resubmitted
+    };
+
+    struct Completion
+    {
+      Mut<u32> slot{};
+      Mut<i64> result{}; // Bytes transferred, or a negative error code
+    };
+
+    Mut<Backend> backend{Backend::ThreadPool};
+    Mut<u32> queue_depth{};
+
+    Mut<Vec<Request>> slots;
+    Mut<Vec<u32>> free_slots;
+    Mut<std::deque<u32>> queued;
+    Mut<u32> in_flight{0};
+    Mut<Vec<Span<u8>>> registered_buffers;
+
+    // Thread pool backend: filled by pool threads, drained by the owner
+    Mut<std::mutex> completion_mutex;
+    Mut<std::condition_variable> completion_condition;
+    Mut<Vec<Completion>> pool_completions;
+
+#if IA_PLATFORM_LINUX
+    Mut<int> ring_fd{-1};
+    Mut<u32> sq_entries{};
+    Mut<u32> cq_entries{};
+    Mut<void *> sq_ring{MAP_FAILED};
+    Mut<usize> sq_ring_size{};
+    Mut<void *> cq_ring{MAP_FAILED};
+    Mut<usize> cq_ring_size{};
+    Mut<io_uring_sqe *> sqes{};
+    Mut<usize> sqes_size{};
+
+    Mut<u32 *> sq_head{};
+    Mut<u32 *> sq_tail{};
+    Mut<u32 *> sq_mask{};
+    Mut<u32 *> sq_array{};
+    Mut<u32 *> cq_head{};
+    Mut<u32 *> cq_tail{};
+    Mut<u32 *> cq_mask{};
+    Mut<io_uring_cqe *> cqes{};
+
+    auto setup_ring(const u32 queue_depth) -> bool
+    {
+      Mut<io_uring_params> params{};
+      ring_fd = static_cast<int>(::syscall(__NR_io_uring_setup, queue_depth, &params));
+      if (ring_fd < 0)
+      {
+        return false;
+      }
+
+      // IORING_OP_READ / IORING_OP_WRITE arrived together with this feature (5.6)
+      if (!(params.features & IORING_FEAT_RW_CUR_POS))
+      {
+        teardown_ring();
+        return false;
+      }
+
+      sq_entries = params.sq_entries;
+      cq_entries = params.cq_entries;
+      sq_ring_size = params.sq_off.array + params.sq_entries * sizeof(u32);
+      cq_ring_size = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+
+      const bool single_mmap = params.features & IORING_FEAT_SINGLE_MMAP;
+      if (single_mmap)
+      {
+        sq_ring_size = cq_ring_size = std::max(sq_ring_size, cq_ring_size);
+      }
+
+      sq_ring = ::mmap(nullptr, sq_ring_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring_fd,
+                       IORING_OFF_SQ_RING);
+      if (sq_ring == MAP_FAILED)
+      {
+        teardown_ring();
+        return false;
+      }
+
+      if (!single_mmap)
+      {
+        cq_ring = ::mmap(nullptr, cq_ring_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring_fd,
+                         IORING_OFF_CQ_RING);
+        if (cq_ring == MAP_FAILED)
+        {
+          teardown_ring();
+          return false;
+        }
+      }
+
+      sqes_size = params.sq_entries * sizeof(io_uring_sqe);
+      Mut<void *> sqes_ptr = ::mmap(nullptr, sqes_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                                    ring_fd, IORING_OFF_SQES);
+      if (sqes_ptr == MAP_FAILED)
+      {
+        teardown_ring();
+        return false;
+      }
+      sqes = static_cast<io_uring_sqe *>(sqes_ptr);
+
+      u8 *sq = static_cast<u8 *>(sq_ring);
+      u8 *cq = static_cast<u8 *>(single_mmap ? sq_ring : cq_ring);
+      sq_head = reinterpret_cast<u32 *>(sq + params.sq_off.head);
+      sq_tail = reinterpret_cast<u32 *>(sq + params.sq_off.tail);
+      sq_mask = reinterpret_cast<u32 *>(sq + params.sq_off.ring_mask);
+      sq_array = reinterpret_cast<u32 *>(sq + params.sq_off.array);
+      cq_head = reinterpret_cast<u32 *>(cq + params.cq_off.head);
+      cq_tail = reinterpret_cast<u32 *>(cq + params.cq_off.tail);
+      cq_mask = reinterpret_cast<u32 *>(cq + params.cq_off.ring_mask);
+      cqes = reinterpret_cast<io_uring_cqe *>(cq + params.cq_off.cqes);
+
+      backend = Backend::IoUring;
+      return true;
+    }
+
+    auto teardown_ring() -> void
+    {
+      if (sqes)
+      {
+        ::munmap(sqes, sqes_size);
+        sqes = nullptr;
+      }
+      if (cq_ring != MAP_FAILED)
+      {
+        ::munmap(cq_ring, cq_ring_size);
+        cq_ring = MAP_FAILED;
+      }
+      if (sq_ring != MAP_FAILED)
+      {
+        ::munmap(sq_ring, sq_ring_size);
+        sq_ring = MAP_FAILED;
+      }
+      if (ring_fd >= 0)
+      {
+        ::close(ring_fd);
+        ring_fd = -1;
+      }
+    }
+
+    // Submission entries written but not yet consumed by the kernel
+    auto ring_unsubmitted() const -> u32
+    {
+      return *sq_tail - std::atomic_ref<u32>(*sq_head).load(std::memory_order_acquire);
+    }
+
+    auto enter(const u32 min_complete) -> Result<void>
+    {
+      const u32 flags = min_complete > 0 ? IORING_ENTER_GETEVENTS : 0;
+      while (::syscall(__NR_io_uring_enter, ring_fd, ring_unsubmitted(), min_complete, flags, nullptr, 0) < 0)
+      {
+        // EBUSY: the completion queue is full, reaping makes room
+        if (errno == EBUSY && min_complete == 0)
+        {
+          return {};
+        }
+        if (errno != EINTR)
+        {
+          return fail("io_uring_enter failed: {}", errno);
+        }
+      }
+      return {};
+    }
+
+    auto push_to_ring(const u32 slot) -> void
+    {
+      Ref<Request> request = slots[slot];
+      const u32 tail = *sq_tail;
+      const u32 index = tail & *sq_mask;
+
+      MutRef<io_uring_sqe> sqe = sqes[index];
+      std::memset(&sqe, 0, sizeof(sqe));
+      if (request.buffer_index)
+      {
+        sqe.opcode = request.is_write ? IORING_OP_WRITE_FIXED : IORING_OP_READ_FIXED;
+        sqe.buf_index = static_cast<u16>(*request.buffer_index);
+      }
+      else
+      {
+        sqe.opcode = request.is_write ? IORING_OP_WRITE : IORING_OP_READ;
+      }
+      sqe.fd = request.handle;
+      sqe.off = request.offset + request.done;
+      sqe.addr = reinterpret_cast<u64>(request.data + request.done);
+      sqe.len = request.size - request.done;
+      sqe.user_data = slot;
+
+      sq_array[index] = index;
+      std::atomic_ref<u32>(*sq_tail).store(tail + 1, std::memory_order_release);
+    }
+
+    auto reap_ring(MutRef<Vec<Completion>> out) -> void
+    {
+      Mut<u32> head = *cq_head;
+      const u32 tail = std::atomic_ref<u32>(*cq_tail).load(std::memory_order_acquire);
+      for (; head != tail; ++head)
+      {
+        Ref<io_uring_cqe> cqe = cqes[head & *cq_mask];
+        out.push_back({static_cast<u32>(cqe.user_data), cqe.res});
+      }
+      std::atomic_ref<u32>(*cq_head).store(head, std::memory_order_release);
+    }
+#endif
+
+    auto submit() -> Result<u32>
+    {
+      Mut<u32> count = 0;
+
+#if IA_PLATFORM_LINUX
+      if (backend == Backend::IoUring)
+      {
+        while (!queued.empty() && in_flight < std::min(queue_depth, cq_entries) && *sq_tail - *sq_head < sq_entries)
+        {
+          push_to_ring(queued.front());
+          queued.pop_front();
+          ++in_flight;
+          ++count;
+        }
+        if (ring_unsubmitted() > 0)
+        {
+          AU_TRY_PURE(enter(0));
+        }
+        return count;
+      }
+#endif
+
+      for (; !queued.empty() && in_flight < queue_depth; queued.pop_front())
+      {
+        const u32 slot = queued.front();
+        Ref<Request> request = slots[slot];
+        AsyncOps::run_task([this, slot, handle = request.handle, offset = request.offset + request.done,
+                            data = request.data + request.done, size = request.size - request.done,
+                            is_write = request.is_write]() {
+          const i64 result = blocking_transfer(handle, offset, data, size, is_write);
+          // Notify under the lock, the waiter may tear us down as soon as it sees the completion
+          const std::lock_guard<std::mutex> lock(completion_mutex);
+          pool_completions.push_back({slot, result});
+          completion_condition.notify_one();
+        });
+        ++in_flight;
+        ++count;
+      }
+      return count;
+    }
+
+    auto collect(MutRef<Vec<Completion>> out, const bool block) -> Result<void>
+    {
+#if IA_PLATFORM_LINUX
+      if (backend == Backend::IoUring)
+      {
+        reap_ring(out);
+        if (out.empty() && block)
+        {
+          AU_TRY_PURE(enter(1));
+          reap_ring(out);
+        }
+        return {};
+      }
+#endif
+
+      Mut<std::unique_lock<std::mutex>> lock(completion_mutex);
+      if (block)
+      {
+        completion_condition.wait(lock, [this] { return !pool_completions.empty(); });
+      }
+      out.insert(out.end(), pool_completions.begin(), pool_completions.end());
+      pool_completions.clear();
+      return {};
+    }
+
+    // Frees each finished request's slot, then runs its callback (which may queue more requests).
+    // Short transfers short of end of file are queued again for the remainder, so both backends
+    // only report full transfers. Returns the number of requests finished.
+    auto dispatch(Ref<Vec<Completion>> completions) -> u32
+    {
+      Mut<u32> finished = 0;
+      for (Ref<Completion> completion : completions)
+      {
+        MutRef<Request> request = slots[completion.slot];
+        --in_flight;
+
+        if (completion.result > 0 && request.done + completion.result < request.size)
+        {
+          request.done += static_cast<u32>(completion.result);
+          queued.push_front(completion.slot);
+          continue;
+        }
+
+        Mut<CompletionCallback> on_complete = std::move(request.on_complete);
+        const bool is_write = request.is_write;
+        const usize transferred = request.done + static_cast<usize>(std::max<i64>(completion.result, 0));
+        request = {};
+        free_slots.push_back(completion.slot);
+        ++finished;
+
+        if (!on_complete)
+        {
+          continue;
+        }
+        if (completion.result < 0)
+        {
+          on_complete(fail("Async {} failed: {}", is_write ? "write" : "read", -completion.result));
+        }
+        else
+        {
+          on_complete(transferred);
+        }
+      }
+      return finished;
+    }
+
+    auto enqueue(Mut<Request> request) -> Result<void>
+    {
+      Mut<u32> slot;
+      if (free_slots.empty())
+      {
+        slot = static_cast<u32>(slots.size());
+        slots.push_back(std::move(request));
+      }
+      else
+      {
+        slot = free_slots.back();
+        free_slots.pop_back();
+        slots[slot] = std::move(request);
+      }
+      queued.push_back(slot);
+      return {};
+    }
+
+    ~Impl()
+    {
+      // The kernel or pool threads may still write into caller buffers and into this object
+      Mut<Vec<Completion>> completions;
+      while (in_flight > 0)
+      {
+        completions.clear();
+        if (!collect(completions, true))
+        {
+          break;
+        }
+        in_flight -= static_cast<u32>(completions.size());
+      }
+
+#if IA_PLATFORM_LINUX
+      teardown_ring();
+#endif
+    }
+  };
+
+  auto FileOps::AsyncIo::create() -> Result<AsyncIo>
+  {
+    return create(Config{});
+  }
+
+  auto FileOps::AsyncIo::create(Ref<Config> config) -> Result<AsyncIo>
+  {
+    if (config.queue_depth == 0)
+    {
+      return fail("AsyncIo queue depth must be at least 1");
+    }
+
+    Mut<Box<Impl>> impl = make_box<Impl>();
+    impl->queue_depth = config.queue_depth;
+
+#if IA_PLATFORM_LINUX
+    if (!config.force_thread_pool)
+    {
+      impl->setup_ring(config.queue_depth);
+    }
+#endif
+
+    return AsyncIo(std::move(impl));
+  }
+
+  FileOps::AsyncIo::AsyncIo(Mut<Box<Impl>> impl) : m_impl(std::move(impl))
+  {
+  }
+
+  FileOps::AsyncIo::AsyncIo(ForwardRef<AsyncIo> other) = default;
+  auto FileOps::AsyncIo::operator=(ForwardRef<AsyncIo> other) -> MutRef<AsyncIo> = default;
+  FileOps::AsyncIo::~AsyncIo() = default;
+
+  auto FileOps::AsyncIo::read(const NativeFileHandle handle, const u64 offset, const Span<u8> buffer,
+                              Mut<CompletionCallback> on_complete) -> Result<void>
+  {
+    if (buffer.size() > MAX_REQUEST_SIZE)
+    {
+      return fail("Async read of {} bytes exceeds the {} byte request limit", buffer.size(), MAX_REQUEST_SIZE);
+    }
+    return m_impl->enqueue({.handle = handle,
+                            .offset = offset,
+                            .data = buffer.data(),
+                            .size = static_cast<u32>(buffer.size()),
+                            .is_write = false,
+                            .buffer_index = {},
+                            .on_complete = std::move(on_complete)});
+  }
+
+  auto FileOps::AsyncIo::write(const NativeFileHandle handle, const u64 offset, const Span<const u8> data,
+                               Mut<CompletionCallback> on_complete) -> Result<void>
+  {
+    if (data.size() > MAX_REQUEST_SIZE)
+    {
+      return fail("Async write of {} bytes exceeds the {} byte request limit", data.size(), MAX_REQUEST_SIZE);
+    }
+    return m_impl->enqueue({.handle = handle,
+                            .offset = offset,
+                            .data = const_cast<u8 *>(data.data()),
+                            .size = static_cast<u32>(data.size()),
+                            .is_write = true,
+                            .buffer_index = {},
+                            .on_complete = std::move(on_complete)});
+  }
+
+  auto FileOps::AsyncIo::register_buffers(const Span<const Span<u8>> buffers) -> Result<void>
+  {
+    if (outstanding() > 0)
+    {
+      return fail("Cannot register buffers while requests are outstanding");
+    }
+
+#if IA_PLATFORM_LINUX
+    if (m_impl->backend == Backend::IoUring)
+    {
+      if (!m_impl->registered_buffers.empty())
+      {
+        ::syscall(__NR_io_uring_register, m_impl->ring_fd, IORING_UNREGISTER_BUFFERS, nullptr, 0);
+        m_impl->registered_buffers.clear();
+      }
+
+      if (!buffers.empty())
+      {
+        Mut<Vec<iovec>> iovecs;
+        iovecs.reserve(buffers.size());
+        for (Ref<Span<u8>> buffer : buffers)
+        {
+          iovecs.push_back({buffer.data(), buffer.size()});
+        }
+
+        if (::syscall(__NR_io_uring_register, m_impl->ring_fd, IORING_REGISTER_BUFFERS, iovecs.data(),
+                      static_cast<u32>(iovecs.size())) < 0)
+        {
+          return fail("Failed to register {} buffers with io_uring: {}", buffers.size(), errno);
+        }
+      }
+    }
+#endif
+
+    m_impl->registered_buffers.assign(buffers.begin(), buffers.end());
+    return {};
+  }
+
+  auto FileOps::AsyncIo::read_fixed(const NativeFileHandle handle, const u64 offset, const u32 buffer_index,
+                                    const Span<u8> buffer, Mut<CompletionCallback> on_complete) -> Result<void>
+  {
+    if (buffer_index >= m_impl->registered_buffers.size())
+    {
+      return fail("No registered buffer {}", buffer_index);
+    }
+
+    Ref<Span<u8>> registered = m_impl->registered_buffers[buffer_index];
+    if (buffer.data() < registered.data() || buffer.data() + buffer.size() > registered.data() + registered.size())
+    {
+      return fail("Buffer is outside registered buffer {}", buffer_index);
+    }
+
+    AU_TRY_PURE(read(handle, offset, buffer, std::move(on_complete)));
+    m_impl->slots[m_impl->queued.back()].buffer_index = buffer_index;
+    return {};
+  }
+
+  auto FileOps::AsyncIo::write_fixed(const NativeFileHandle handle, const u64 offset, const u32 buffer_index,
+                                     const Span<const u8> data, Mut<CompletionCallback> on_complete) -> Result<void>
+  {
+    if (buffer_index >= m_impl->registered_buffers.size())
+    {
+      return fail("No registered buffer {}", buffer_index);
+    }
+
+    Ref<Span<u8>> registered = m_impl->registered_buffers[buffer_index];
+    if (data.data() < registered.data() || data.data() + data.size() > registered.data() + registered.size())
+    {
+      return fail("Buffer is outside registered buffer {}", buffer_index);
+    }
+
+    AU_TRY_PURE(write(handle, offset, data, std::move(on_complete)));
+    m_impl->slots[m_impl->queued.back()].buffer_index = buffer_index;
+    return {};
+  }
+
+  auto FileOps::AsyncIo::submit() -> Result<u32>
+  {
+    return m_impl->submit();
+  }
+
+  auto FileOps::AsyncIo::wait(const u32 min_completions) -> Result<u32>
+  {
+    Mut<u32> completed = 0;
+    Mut<Vec<Impl::Completion>> completions;
+
+    AU_TRY_PURE(m_impl->submit());
+    AU_TRY_PURE(m_impl->collect(completions, false));
+    while (true)
+    {
+      completed += m_impl->dispatch(completions);
+      completions.clear();
+
+      // Callbacks, freed ring space and resubmitted remainders may have let more requests through
+      AU_TRY_PURE(m_impl->submit());
+      if (completed >= min_completions || m_impl->in_flight == 0)
+      {
+        return completed;
+      }
+
+      AU_TRY_PURE(m_impl->collect(completions, true));
+    }
+  }
+
+  auto FileOps::AsyncIo::drain() -> Result<void>
+  {
+    while (outstanding() > 0)
+    {
+      AU_TRY_PURE(wait(static_cast<u32>(outstanding())));
+    }
+    return {};
+  }
+
+  auto FileOps::AsyncIo::outstanding() const -> usize
+  {
+    return m_impl->queued.size() + m_impl->in_flight;
+  }
+
+  auto FileOps::AsyncIo::backend() const -> Backend
+  {
+    return m_impl->backend;
+  }
+
+} // namespace IACore
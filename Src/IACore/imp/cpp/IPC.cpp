@@ -16,12 +16,51 @@
 #include <IACore/IPC.hpp>
 
 #include <IACore/FileOps.hpp>
+#include <IACore/Logger.hpp>
 #include <IACore/StringOps.hpp>
 #include <charconv>
 #include <fcntl.h>
 
 namespace IACore
 {
+  // Compresses `payload` for a push under `packet_id | IPC_COMPRESSED_PACKET_FLAG`
+  static auto compress_ipc_payload(Ref<Option<DataOps::ZstdDictionary>> dictionary, const u16 packet_id,
+                                   const Span<const u8> payload) -> Result<Vec<u8>>
+  {
+    if (!dictionary)
+    {
+      return fail("no compression dictionary set");
+    }
+    if (packet_id & IPC_COMPRESSED_PACKET_FLAG)
+    {
+      return fail("packet id {} collides with IPC_COMPRESSED_PACKET_FLAG", packet_id);
+    }
+    return DataOps::zstd_deflate(payload, *dictionary);
+  }
+
+  // Returns false if the packet was compressed but could not be inflated and should be dropped
+  static auto inflate_ipc_payload(Ref<Option<DataOps::ZstdDictionary>> dictionary, MutRef<u16> packet_id,
+                                  MutRef<Span<const u8>> payload, MutRef<Vec<u8>> storage) -> bool
+  {
+    if (!dictionary || !(packet_id & IPC_COMPRESSED_PACKET_FLAG))
+    {
+      return true;
+    }
+
+    Mut<Result<Vec<u8>>> inflated = DataOps::zstd_inflate(payload, *dictionary);
+    if (!inflated)
+    {
+      IA_LOG_WARN("[IPC] Dropping compressed packet {}: {}", packet_id & ~IPC_COMPRESSED_PACKET_FLAG,
+                  inflated.error());
+      return false;
+    }
+
+    storage = std::move(*inflated);
+    packet_id &= static_cast<u16>(~IPC_COMPRESSED_PACKET_FLAG);
+    payload = Span<const u8>(storage);
+    return true;
+  }
+
   struct IpcConnectionDescriptor
   {
     Mut<String> socket_path;
@@ -147,9 +186,15 @@ namespace IACore
 
     Mut<IpcPacketHeader> header;
 
+    Mut<Vec<u8>> inflated;
     while (m_moni.pop(header, Span<u8>(m_receive_buffer.data(), m_receive_buffer.size())))
     {
-      on_packet(header.id, {m_receive_buffer.data(), header.payload_size});
+      Mut<u16> packet_id = header.id;
+      Mut<Span<const u8>> payload{m_receive_buffer.data(), header.payload_size};
+      if (inflate_ipc_payload(m_compression_dictionary, packet_id, payload, inflated))
+      {
+        on_packet(packet_id, payload);
+      }
     }
 
     Mut<u8> signal = 0;
@@ -182,6 +227,17 @@ namespace IACore
     return m_mino.push(packet_id, payload);
   }
 
+  auto IpcNode::set_compression_dictionary(ForwardRef<DataOps::ZstdDictionary> dictionary) -> void
+  {
+    m_compression_dictionary.emplace(std::move(dictionary));
+  }
+
+  auto IpcNode::send_compressed_packet(const u16 packet_id, const Span<const u8> payload) -> Result<void>
+  {
+    const Vec<u8> compressed = AU_TRY(compress_ipc_payload(m_compression_dictionary, packet_id, payload));
+    return send_packet(static_cast<u16>(packet_id | IPC_COMPRESSED_PACKET_FLAG), compressed);
+  }
+
   void IpcManager::NodeSession::send_signal(const u8 signal)
   {
     if (data_socket != INVALID_SOCKET)
@@ -283,9 +339,15 @@ namespace IACore
 
       Mut<IpcPacketHeader> header;
 
+      Mut<Vec<u8>> inflated;
       while (node->mino.pop(header, Span<u8>(m_receive_buffer.data(), m_receive_buffer.size())))
       {
-        on_packet(node_id, header.id, {m_receive_buffer.data(), header.payload_size});
+        Mut<u16> packet_id = header.id;
+        Mut<Span<const u8>> payload{m_receive_buffer.data(), header.payload_size};
+        if (inflate_ipc_payload(m_compression_dictionary, packet_id, payload, inflated))
+        {
+          on_packet(node_id, packet_id, payload);
+        }
       }
 
       Mut<u8> signal = 0;
@@ -468,4 +530,16 @@ namespace IACore
       return fail("no such node");
     return it_node->second->send_packet(packet_id, payload);
   }
+
+  auto IpcManager::set_compression_dictionary(ForwardRef<DataOps::ZstdDictionary> dictionary) -> void
+  {
+    m_compression_dictionary.emplace(std::move(dictionary));
+  }
+
+  auto IpcManager::send_compressed_packet(const NativeProcessID node, const u16 packet_id,
+                                          const Span<const u8> payload) -> Result<void>
+  {
+    const Vec<u8> compressed = AU_TRY(compress_ipc_payload(m_compression_dictionary, packet_id, payload));
+    return send_packet(node, static_cast<u16>(packet_id | IPC_COMPRESSED_PACKET_FLAG), compressed);
+  }
 } // namespace IACore
\ No newline at end of file
@@ -64,8 +64,9 @@ namespace IACore
     const bool osxsave = (cpu_info[2] & (1 << 27)) != 0;
     const bool avx = (cpu_info[2] & (1 << 28)) != 0;
     const bool fma = (cpu_info[2] & (1 << 12)) != 0;
+    const bool pclmul = (cpu_info[2] & (1 << 1)) != 0;
 
-    if (!osxsave || !avx || !fma)
+    if (!osxsave || !avx || !fma || !pclmul)
     {
       return false;
     }
@@ -84,6 +85,7 @@ namespace IACore
     }
 
     s_capabilities.hardware_crc32 = true;
+    s_capabilities.hardware_clmul = true;
 
 #elif defined(IA_ARCH_ARM64)
 #  if defined(__linux__) || defined(__ANDROID__)
@@ -91,16 +93,23 @@ namespace IACore
 
 #    ifndef HWCAP_CRC32
 #      define HWCAP_CRC32 (1 << 7)
+#    endif
+#    ifndef HWCAP_PMULL
+#      define HWCAP_PMULL (1 << 4)
 #    endif
 
     s_capabilities.hardware_crc32 = (hw_caps & HWCAP_CRC32) != 0;
+    s_capabilities.hardware_clmul = (hw_caps & HWCAP_PMULL) != 0;
 #  elif defined(IA_PLATFORM_APPLE)
     s_capabilities.hardware_crc32 = true;
+    s_capabilities.hardware_clmul = true;
 #  else
     s_capabilities.hardware_crc32 = false;
+    s_capabilities.hardware_clmul = false;
 #  endif
 #else
     s_capabilities.hardware_crc32 = false;
+    s_capabilities.hardware_clmul = false;
 #endif
     return true;
   }
@@ -18,6 +18,22 @@
 
 namespace IACore
 {
+  struct StreamReader::FileWindow
+  {
+    Mut<NativeFileHandle> handle{INVALID_FILE_HANDLE};
+    Mut<FileOps::MemoryMappedRegion> region;
+    Mut<usize> window_size{};
+
+    ~FileWindow()
+    {
+      region.unmap();
+      if (handle != INVALID_FILE_HANDLE)
+      {
+        FileOps::native_close_file(handle);
+      }
+    }
+  };
+
   auto StreamReader::create_from_file(Ref<Path> path) -> Result<StreamReader>
   {
     Mut<usize> size = 0;
@@ -30,25 +46,69 @@ namespace IACore
     return reader;
   }
 
+  auto StreamReader::create_from_file(Ref<Path> path, Ref<FileConfig> config) -> Result<StreamReader>
+  {
+    if (config.window_size == 0)
+    {
+      return create_from_file(path);
+    }
+
+    Mut<std::error_code> ec;
+    const uintmax_t file_size = std::filesystem::file_size(path, ec);
+    if (ec)
+    {
+      return fail("Failed to get size of {}: {}", path.string(), ec.message());
+    }
+    if (file_size > std::numeric_limits<usize>::max())
+    {
+      return fail("File {} is too large to stream on this platform", path.string());
+    }
+
+    Mut<Box<FileWindow>> window = make_box<FileWindow>();
+    window->handle =
+        AU_TRY(FileOps::native_open_file(path, FileOps::FileAccess::Read, FileOps::FileMode::OpenExisting));
+
+    const usize alignment = FileOps::MemoryMappedRegion::offset_alignment();
+    window->window_size = (config.window_size + alignment - 1) / alignment * alignment;
+
+    Mut<StreamReader> reader(Span<const u8>{});
+    reader.m_data_size = static_cast<usize>(file_size);
+    reader.m_file_window = std::move(window);
+    reader.m_storage_type = StorageType::WindowedFile;
+
+    if (reader.m_data_size > 0)
+    {
+      AU_TRY_PURE(reader.slide_window(0));
+    }
+
+    return reader;
+  }
+
   StreamReader::StreamReader(ForwardRef<Vec<u8>> data)
       : m_owning_vector(std::move(data)), m_storage_type(StorageType::OwningVector)
   {
     m_data = m_owning_vector.data();
     m_data_size = m_owning_vector.size();
+    m_window_size = m_data_size;
   }
 
   StreamReader::StreamReader(const Span<const u8> data)
-      : m_data(data.data()), m_data_size(data.size()), m_storage_type(StorageType::NonOwning)
+      : m_data(data.data()), m_data_size(data.size()), m_window_size(data.size()),
+        m_storage_type(StorageType::NonOwning)
   {
   }
 
   StreamReader::StreamReader(ForwardRef<StreamReader> other)
       : m_data(other.m_data), m_cursor(other.m_cursor), m_data_size(other.m_data_size),
-        m_owning_vector(std::move(other.m_owning_vector)), m_storage_type(other.m_storage_type)
+        m_window_offset(other.m_window_offset), m_window_size(other.m_window_size),
+        m_file_window(std::move(other.m_file_window)), m_owning_vector(std::move(other.m_owning_vector)),
+        m_storage_type(other.m_storage_type)
   {
     other.m_storage_type = StorageType::NonOwning;
     other.m_data = {};
     other.m_data_size = 0;
+    other.m_window_offset = 0;
+    other.m_window_size = 0;
 
     if (m_storage_type == StorageType::OwningVector)
     {
@@ -68,6 +128,9 @@ namespace IACore
       m_data = other.m_data;
       m_cursor = other.m_cursor;
       m_data_size = other.m_data_size;
+      m_window_offset = other.m_window_offset;
+      m_window_size = other.m_window_size;
+      m_file_window = std::move(other.m_file_window);
       m_owning_vector = std::move(other.m_owning_vector);
       m_storage_type = other.m_storage_type;
 
@@ -79,6 +142,8 @@ namespace IACore
       other.m_storage_type = StorageType::NonOwning;
       other.m_data = {};
       other.m_data_size = 0;
+      other.m_window_offset = 0;
+      other.m_window_size = 0;
     }
     return *this;
   }
@@ -90,4 +155,60 @@ namespace IACore
       FileOps::unmap_file(m_data);
     }
   }
-} // namespace IACore
\ No newline at end of file
+
+  auto StreamReader::read_outside_window(Mut<void *> buffer, const usize size) -> Result<void>
+  {
+    if (m_storage_type != StorageType::WindowedFile || size > m_data_size - m_cursor)
+    {
+      return fail("Unexpected EOF while reading");
+    }
+
+    Mut<u8 *> out = static_cast<u8 *>(buffer);
+    Mut<usize> remaining = size;
+    while (remaining > 0)
+    {
+      if (!in_window(1))
+      {
+        AU_TRY_PURE(slide_window(m_cursor));
+      }
+
+      const usize window_cursor = m_cursor - m_window_offset;
+      const usize chunk = std::min(remaining, m_window_size - window_cursor);
+      std::memcpy(out, &m_data[window_cursor], chunk);
+      out += chunk;
+      m_cursor += chunk;
+      remaining -= chunk;
+    }
+
+    return {};
+  }
+
+  auto StreamReader::map_for_view(const usize size) -> Result<void>
+  {
+    if (m_storage_type != StorageType::WindowedFile || size > m_data_size - m_cursor)
+    {
+      return fail("Unexpected EOF while reading");
+    }
+
+    return slide_window(m_cursor, size);
+  }
+
+  auto StreamReader::slide_window(const usize pos, const usize min_size) -> Result<void>
+  {
+    MutRef<FileWindow> window = *m_file_window;
+    const usize offset = pos - pos % FileOps::MemoryMappedRegion::offset_alignment();
+    const usize size = std::min(std::max(window.window_size, pos - offset + min_size), m_data_size - offset);
+
+    // Leaves nothing readable if mapping fails
+    m_data = nullptr;
+    m_window_offset = 0;
+    m_window_size = 0;
+
+    AU_TRY_PURE(window.region.map(window.handle, offset, size, true));
+
+    m_data = window.region.get_ptr();
+    m_window_offset = offset;
+    m_window_size = size;
+    return {};
+  }
+} // namespace IACore
@@ -13,32 +13,143 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <IACore/AsyncOps.hpp>
+#include <IACore/FileOps.hpp>
 #include <IACore/StreamWriter.hpp>
+#include <cstdlib>
+
+#if IA_PLATFORM_UNIX
+#  include <unistd.h>
+#endif
 
 namespace IACore
 {
 
+  struct StreamWriter::FileSink
+  {
+    Mut<NativeFileHandle> handle{INVALID_FILE_HANDLE};
+
+    // The second buffer is only allocated when double-buffered
+    Mut<Array<Vec<u8>, 2>> buffers;
+    Mut<u32> active{0};
+    Mut<bool> double_buffered{false};
+
+    Mut<std::mutex> mutex;
+    Mut<std::condition_variable> condition;
+    Mut<bool> write_in_flight{false};
+    Mut<Option<String>> error; // Sticky, the file contents are undefined after a failed write
+
+    ~FileSink()
+    {
+      Mut<std::unique_lock<std::mutex>> lock(mutex);
+      condition.wait(lock, [this] { return !write_in_flight; });
+      lock.unlock();
+
+      if (handle != INVALID_FILE_HANDLE)
+      {
+        FileOps::native_close_file(handle);
+      }
+    }
+
+    auto write_all(Mut<const u8 *> data, Mut<usize> size) -> Result<void>
+    {
+      while (size > 0)
+      {
+#if IA_PLATFORM_WINDOWS
+        Mut<DWORD> written = 0;
+        if (!WriteFile(handle, data, static_cast<DWORD>(std::min<usize>(size, 0x40000000)), &written, NULL))
+        {
+          return fail("Failed to write to file: {}", GetLastError());
+        }
+#else
+        const ssize_t written = ::write(handle, data, size);
+        if (written < 0)
+        {
+          if (errno == EINTR)
+          {
+            continue;
+          }
+          return fail("Failed to write to file: {}", errno);
+        }
+#endif
+        data += written;
+        size -= static_cast<usize>(written);
+      }
+      return {};
+    }
+
+    auto wait_for_background_write() -> Result<void>
+    {
+      Mut<std::unique_lock<std::mutex>> lock(mutex);
+      condition.wait(lock, [this] { return !write_in_flight; });
+      if (error)
+      {
+        return fail("{}", *error);
+      }
+      return {};
+    }
+
+    // Caller must have waited for the previous background write
+    auto start_background_write(const u32 buffer_index, const usize size) -> void
+    {
+      write_in_flight = true;
+      AsyncOps::run_task([this, buffer_index, size]() {
+        const Result<void> res = write_all(buffers[buffer_index].data(), size);
+        const std::lock_guard<std::mutex> lock(mutex);
+        if (!res)
+        {
+          error = res.error();
+        }
+        write_in_flight = false;
+        condition.notify_all();
+      });
+    }
+  };
+
   auto StreamWriter::create_from_file(Ref<Path> path) -> Result<StreamWriter>
   {
-    Mut<FILE *> f = std::fopen(path.string().c_str(), "wb");
-    if (!f)
+    return create_from_file(path, FileConfig{});
+  }
+
+  auto StreamWriter::create_from_file(Ref<Path> path, Ref<FileConfig> config) -> Result<StreamWriter>
+  {
+    if (config.buffer_size == 0)
     {
-      return fail("Failed to open file for writing: {}", path.string());
+      return fail("StreamWriter file buffer size must be at least 1 byte");
     }
-    std::fclose(f);
 
-    Mut<StreamWriter> writer;
-    writer.m_file_path = path;
+    Mut<Box<FileSink>> sink = make_box<FileSink>();
+    sink->handle =
+        AU_TRY(FileOps::native_open_file(path, FileOps::FileAccess::Write, FileOps::FileMode::CreateAlways));
+    sink->double_buffered = config.double_buffered;
+    sink->buffers[0].resize(config.buffer_size);
+    if (config.double_buffered)
+    {
+      sink->buffers[1].resize(config.buffer_size);
+    }
+
+    Mut<StreamWriter> writer(Span<u8>{});
+    writer.m_buffer = sink->buffers[0].data();
+    writer.m_capacity = config.buffer_size;
+    writer.m_file_sink = std::move(sink);
     writer.m_storage_type = StorageType::OwningFile;
 
     return writer;
   }
 
-  StreamWriter::StreamWriter() : m_storage_type(StorageType::OwningVector)
+  StreamWriter::StreamWriter() : StreamWriter(BufferConfig{})
   {
-    m_capacity = 256;
-    m_owning_vector.resize(m_capacity);
-    m_buffer = m_owning_vector.data();
+  }
+
+  StreamWriter::StreamWriter(Ref<BufferConfig> config)
+      : m_max_chunk_size(std::max<usize>(config.max_chunk_size, 1)), m_arena(config.arena),
+        m_storage_type(config.segmented ? StorageType::OwningSegments : StorageType::OwningVector)
+  {
+    if (config.initial_capacity > 0)
+    {
+      m_buffer = allocate_block(config.initial_capacity);
+      m_capacity = m_buffer ? config.initial_capacity : 0;
+    }
   }
 
   StreamWriter::StreamWriter(const Span<u8> data)
@@ -48,15 +159,14 @@ namespace IACore
 
   StreamWriter::StreamWriter(ForwardRef<StreamWriter> other)
       : m_buffer(other.m_buffer), m_cursor(other.m_cursor), m_capacity(other.m_capacity),
-        m_file_path(other.m_file_path), m_owning_vector(std::move(other.m_owning_vector)),
-        m_storage_type(other.m_storage_type)
+        m_flushed(other.m_flushed), m_file_sink(std::move(other.m_file_sink)),
+        m_full_chunks(std::move(other.m_full_chunks)), m_max_chunk_size(other.m_max_chunk_size),
+        m_arena(other.m_arena), m_storage_type(other.m_storage_type)
   {
     other.m_capacity = {};
     other.m_buffer = {};
+    other.m_full_chunks.clear();
     other.m_storage_type = StorageType::NonOwning;
-
-    if (m_storage_type == StorageType::OwningVector)
-      m_buffer = m_owning_vector.data();
   }
 
   auto StreamWriter::operator=(ForwardRef<StreamWriter> other) -> MutRef<StreamWriter>
@@ -70,20 +180,23 @@ namespace IACore
           std::fprintf(stderr, "[IACore] Data loss in StreamWriter move: %s\n", res.error().c_str());
         }
       }
+      release();
 
       m_buffer = other.m_buffer;
       m_cursor = other.m_cursor;
       m_capacity = other.m_capacity;
-      m_file_path = std::move(other.m_file_path);
-      m_owning_vector = std::move(other.m_owning_vector);
+      m_flushed = other.m_flushed;
+      m_file_sink = std::move(other.m_file_sink);
+      m_full_chunks = std::move(other.m_full_chunks);
+      m_max_chunk_size = other.m_max_chunk_size;
+      m_arena = other.m_arena;
       m_storage_type = other.m_storage_type;
 
-      if (m_storage_type == StorageType::OwningVector)
-        m_buffer = m_owning_vector.data();
-
       other.m_capacity = 0;
       other.m_cursor = 0;
+      other.m_flushed = 0;
       other.m_buffer = nullptr;
+      other.m_full_chunks.clear();
       other.m_storage_type = StorageType::NonOwning;
     }
     return *this;
@@ -98,38 +211,182 @@ namespace IACore
         std::fprintf(stderr, "[IACore] LOST DATA in ~StreamWriter: %s\n", res.error().c_str());
       }
     }
+    release();
   }
 
-  auto StreamWriter::flush() -> Result<void>
+  auto StreamWriter::release() -> void
   {
-    Mut<Result<void>> res = flush_to_disk();
-    if (res.has_value())
+    if (m_storage_type != StorageType::OwningVector && m_storage_type != StorageType::OwningSegments)
+    {
+      return;
+    }
+
+    for (Ref<Chunk> chunk : m_full_chunks)
     {
-      m_storage_type = StorageType::OwningVector;
+      free_block(chunk.data, chunk.capacity);
     }
-    return res;
+    m_full_chunks.clear();
+
+    free_block(m_buffer, m_capacity);
+    m_buffer = nullptr;
+    m_capacity = 0;
+  }
+
+  auto StreamWriter::allocate_block(const usize size) -> u8 *
+  {
+    if (m_arena)
+    {
+      return static_cast<u8 *>(m_arena->allocate(size, alignof(std::max_align_t)));
+    }
+    return static_cast<u8 *>(std::malloc(size));
+  }
+
+  auto StreamWriter::free_block(Mut<u8 *> block, const usize size) -> void
+  {
+    if (!block)
+    {
+      return;
+    }
+
+    if (m_arena)
+    {
+      m_arena->deallocate(block, size, alignof(std::max_align_t));
+    }
+    else
+    {
+      std::free(block);
+    }
+  }
+
+  auto StreamWriter::grow_buffer(const usize capacity) -> Result<void>
+  {
+    Mut<u8 *> grown;
+    if (m_arena)
+    {
+      grown = allocate_block(capacity);
+      if (grown && m_buffer)
+      {
+        std::memcpy(grown, m_buffer, m_cursor);
+        free_block(m_buffer, m_capacity);
+      }
+    }
+    else
+    {
+      grown = static_cast<u8 *>(std::realloc(m_buffer, capacity));
+    }
+
+    if (!grown)
+    {
+      return fail("StreamWriter failed to grow to {} bytes", capacity);
+    }
+
+    m_buffer = grown;
+    m_capacity = capacity;
+    return {};
+  }
+
+  auto StreamWriter::start_chunk(const usize size) -> Result<void>
+  {
+    const usize capacity = std::max(std::min(std::max<usize>(m_capacity * 2, 256), m_max_chunk_size), size);
+
+    Mut<u8 *> chunk = allocate_block(capacity);
+    if (!chunk)
+    {
+      return fail("StreamWriter failed to allocate a {} byte chunk", capacity);
+    }
+
+    // An empty chunk is swapped out rather than kept
+    if (m_cursor == 0)
+    {
+      free_block(m_buffer, m_capacity);
+    }
+    else
+    {
+      m_full_chunks.push_back({m_buffer, m_cursor, m_capacity});
+      m_flushed += m_cursor;
+    }
+
+    m_buffer = chunk;
+    m_cursor = 0;
+    m_capacity = capacity;
+    return {};
+  }
+
+  auto StreamWriter::reserve(const usize size) -> Result<void>
+  {
+    if (size <= m_capacity - m_cursor)
+    {
+      return {};
+    }
+
+    switch (m_storage_type)
+    {
+    case StorageType::NonOwning:
+      return fail("StreamWriter buffer overflow (NonOwning)");
+    case StorageType::OwningFile:
+      return {}; // The buffer drains as it fills
+    case StorageType::OwningVector:
+      return grow_buffer(m_cursor + size);
+    case StorageType::OwningSegments:
+      return start_chunk(size);
+    }
+    return {};
+  }
+
+  auto StreamWriter::segments() const -> Vec<Span<const u8>>
+  {
+    Mut<Vec<Span<const u8>>> result;
+    result.reserve(m_full_chunks.size() + 1);
+    for (Ref<Chunk> chunk : m_full_chunks)
+    {
+      result.push_back(Span<const u8>(chunk.data, chunk.size));
+    }
+    if (m_cursor > 0)
+    {
+      result.push_back(Span<const u8>(m_buffer, m_cursor));
+    }
+    return result;
+  }
+
+  auto StreamWriter::flush() -> Result<void>
+  {
+    return flush_to_disk();
   }
 
   auto StreamWriter::flush_to_disk() -> Result<void>
   {
-    if (m_storage_type != StorageType::OwningFile || m_file_path.empty())
+    if (m_storage_type != StorageType::OwningFile || !m_file_sink)
     {
       return {};
     }
 
-    Mut<FILE *> f = std::fopen(m_file_path.string().c_str(), "wb");
-    if (!f)
+    AU_TRY_PURE(drain_buffer());
+    return m_file_sink->wait_for_background_write();
+  }
+
+  auto StreamWriter::drain_buffer() -> Result<void>
+  {
+    if (m_cursor == 0)
     {
-      return fail("Failed to open file for writing: {}", m_file_path.string());
+      return {};
     }
 
-    const usize written = std::fwrite(m_buffer, 1, m_cursor, f);
-    std::fclose(f);
+    MutRef<FileSink> sink = *m_file_sink;
+    AU_TRY_PURE(sink.wait_for_background_write());
 
-    if (written != m_cursor)
+    if (sink.double_buffered)
     {
-      return fail("Incomplete write: {} of {} bytes written", written, m_cursor);
+      sink.start_background_write(sink.active, m_cursor);
+      sink.active ^= 1;
+      m_buffer = sink.buffers[sink.active].data();
     }
+    else
+    {
+      AU_TRY_PURE(sink.write_all(m_buffer, m_cursor));
+    }
+
+    m_flushed += m_cursor;
+    m_cursor = 0;
     return {};
   }
 
@@ -142,13 +399,24 @@ namespace IACore
         return fail("StreamWriter buffer overflow (NonOwning)");
       }
 
-      const usize required = m_cursor + count;
-      const usize double_cap = m_capacity * 2;
-      const usize new_capacity = (double_cap > required) ? double_cap : required;
+      if (m_storage_type == StorageType::OwningFile || m_storage_type == StorageType::OwningSegments)
+      {
+        Mut<usize> remaining = count;
+        while (remaining > 0)
+        {
+          if (m_cursor == m_capacity)
+          {
+            AU_TRY_PURE(m_storage_type == StorageType::OwningFile ? drain_buffer() : start_chunk(remaining));
+          }
+          const usize chunk = std::min(remaining, m_capacity - m_cursor);
+          std::memset(m_buffer + m_cursor, byte, chunk);
+          m_cursor += chunk;
+          remaining -= chunk;
+        }
+        return {};
+      }
 
-      m_owning_vector.resize(new_capacity);
-      m_capacity = m_owning_vector.size();
-      m_buffer = m_owning_vector.data();
+      AU_TRY_PURE(grow_buffer(std::max(m_capacity * 2, m_cursor + count)));
     }
 
     std::memset(m_buffer + m_cursor, byte, count);
@@ -160,18 +428,41 @@ namespace IACore
   {
     if (m_cursor + size > m_capacity)
     {
-      if (m_storage_type == StorageType::NonOwning)
+      switch (m_storage_type)
       {
+      case StorageType::NonOwning:
         return fail("StreamWriter buffer overflow (NonOwning)");
-      }
 
-      const usize required = m_cursor + size;
-      const usize double_cap = m_capacity * 2;
-      const usize new_capacity = (double_cap > required) ? double_cap : required;
+      case StorageType::OwningFile:
+        AU_TRY_PURE(drain_buffer());
+        if (size >= m_capacity)
+        {
+          // Copying through the buffer would gain nothing
+          AU_TRY_PURE(m_file_sink->wait_for_background_write());
+          AU_TRY_PURE(m_file_sink->write_all(static_cast<const u8 *>(buffer), size));
+          m_flushed += size;
+          return {};
+        }
+        break;
+
+      case StorageType::OwningSegments: {
+        // Fill the current chunk, the rest goes to a new one
+        const usize head = m_capacity - m_cursor;
+        if (head > 0)
+        {
+          std::memcpy(m_buffer + m_cursor, buffer, head);
+          m_cursor += head;
+        }
+        AU_TRY_PURE(start_chunk(size - head));
+        std::memcpy(m_buffer, static_cast<const u8 *>(buffer) + head, size - head);
+        m_cursor = size - head;
+        return {};
+      }
 
-      m_owning_vector.resize(new_capacity);
-      m_capacity = m_owning_vector.size();
-      m_buffer = m_owning_vector.data();
+      case StorageType::OwningVector:
+        AU_TRY_PURE(grow_buffer(std::max(m_capacity * 2, m_cursor + size)));
+        break;
+      }
     }
 
     std::memcpy(m_buffer + m_cursor, buffer, size);
@@ -179,4 +470,4 @@ namespace IACore
     return {};
   }
 
-} // namespace IACore
\ No newline at end of file
+} // namespace IACore
@@ -13,128 +13,367 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <IACore/SIMD.hpp>
 #include <IACore/StringOps.hpp>
 
 namespace IACore
 {
+  constexpr const u8 BASE64_INVALID = 0xFF;
 
-  static const String BASE64_CHAR_TABLE = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+  // Everything the scalar and SIMD paths need for one alphabet, derived from the two characters
+  // that differ between alphabets (values 62 and 63).
+  struct Base64Tables
+  {
+    Mut<Array<char, 64>> alphabet{};
+    Mut<Array<u8, 256>> decode{}; // 6-bit value per character, BASE64_INVALID if outside the alphabet
+    Mut<u8> char_62{};
+    Mut<u8> char_63{};
+
+    // Encoding: a 6-bit value is classified into one of 14 ranges (see encode_base64_block),
+    // `encode_offsets[range]` turns it into its character
+    alignas(16) Mut<Array<u8, 16>> encode_offsets{};
+
+    // Decoding: a character is valid iff (invalid_by_lo[lo nibble] & bit_by_hi[hi nibble]) == 0.
+    // Each high nibble holding valid characters gets its own bit, the rest share one.
+    alignas(16) Mut<Array<u8, 16>> invalid_by_lo{};
+    alignas(16) Mut<Array<u8, 16>> bit_by_hi{};
+
+    // Added to a letter or digit, by high nibble, to get its value. 62 and 63 are patched separately.
+    alignas(16) Mut<Array<u8, 16>> roll_by_hi{};
+  };
+
+  constexpr auto make_base64_tables(const char char_62, const char char_63) -> Base64Tables
+  {
+    Mut<Base64Tables> tables{};
+    tables.char_62 = static_cast<u8>(char_62);
+    tables.char_63 = static_cast<u8>(char_63);
+
+    for (Mut<u32> i = 0; i < 26; ++i)
+    {
+      tables.alphabet[i] = static_cast<char>('A' + i);
+      tables.alphabet[26 + i] = static_cast<char>('a' + i);
+    }
+    for (Mut<u32> i = 0; i < 10; ++i)
+    {
+      tables.alphabet[52 + i] = static_cast<char>('0' + i);
+    }
+    tables.alphabet[62] = char_62;
+    tables.alphabet[63] = char_63;
+
+    for (MutRef<u8> entry : tables.decode)
+    {
+      entry = BASE64_INVALID;
+    }
+    for (Mut<u32> i = 0; i < 64; ++i)
+    {
+      tables.decode[static_cast<u8>(tables.alphabet[i])] = static_cast<u8>(i);
+    }
+
+    // Ranges: 0 -> 26..51, 1..10 -> 52..61, 11 -> 62, 12 -> 63, 13 -> 0..25
+    tables.encode_offsets[0] = static_cast<u8>('a' - 26);
+    for (Mut<u32> i = 1; i <= 10; ++i)
+    {
+      tables.encode_offsets[i] = static_cast<u8>('0' - 52);
+    }
+    tables.encode_offsets[11] = static_cast<u8>(char_62 - 62);
+    tables.encode_offsets[12] = static_cast<u8>(char_63 - 63);
+    tables.encode_offsets[13] = static_cast<u8>('A');
+
+    constexpr const u8 SHARED_INVALID_BIT = 0x80;
+    Mut<u8> next_bit = 1;
+    for (Mut<u32> hi = 0; hi < 16; ++hi)
+    {
+      Mut<bool> has_valid = false;
+      for (Mut<u32> lo = 0; lo < 16; ++lo)
+      {
+        const u8 value = tables.decode[hi << 4 | lo];
+        if (value != BASE64_INVALID)
+        {
+          has_valid = true;
+          if (value < 62)
+          {
+            tables.roll_by_hi[hi] = static_cast<u8>(value - (hi << 4 | lo));
+          }
+        }
+      }
 
-  static auto is_base64(const u8 c) -> bool
+      if (has_valid)
+      {
+        tables.bit_by_hi[hi] = next_bit;
+        next_bit = static_cast<u8>(next_bit << 1);
+      }
+      else
+      {
+        tables.bit_by_hi[hi] = SHARED_INVALID_BIT;
+      }
+
+      for (Mut<u32> lo = 0; lo < 16; ++lo)
+      {
+        if (tables.decode[hi << 4 | lo] == BASE64_INVALID)
+        {
+          tables.invalid_by_lo[lo] |= tables.bit_by_hi[hi];
+        }
+      }
+    }
+
+    return tables;
+  }
+
+  constexpr const Base64Tables BASE64_STANDARD_TABLES = make_base64_tables('+', '/');
+  constexpr const Base64Tables BASE64_URL_SAFE_TABLES = make_base64_tables('-', '_');
+
+  static auto base64_tables(const StringOps::Base64Alphabet alphabet) -> Ref<Base64Tables>
   {
-    return (c >= 'A' && c <= 'Z') || (c >= 'a' && c <= 'z') || (c >= '0' && c <= '9') || (c == '+') || (c == '/');
+    return alphabet == StringOps::Base64Alphabet::UrlSafe ? BASE64_URL_SAFE_TABLES : BASE64_STANDARD_TABLES;
   }
 
-  static auto get_base64_index(const u8 c) -> u8
+  using Base64Tag = hn::FixedTag<u8, 16>;
+  using Base64Tag16 = hn::Repartition<u16, Base64Tag>;
+  using Base64Tag32 = hn::Repartition<u32, Base64Tag>;
+
+  // Encodes src[0..12) into dst[0..16). Reads 16 bytes from `src`.
+  static auto encode_base64_block(const u8 *src, Mut<u8 *> dst, Ref<Base64Tables> tables) -> void
   {
-    if (c >= 'A' && c <= 'Z')
-      return c - 'A';
-    if (c >= 'a' && c <= 'z')
-      return c - 'a' + 26;
-    if (c >= '0' && c <= '9')
-      return c - '0' + 52;
-    if (c == '+')
-      return 62;
-    if (c == '/')
-      return 63;
-    return 0;
+    const Base64Tag d;
+    const Base64Tag32 d32;
+
+    alignas(16) static constexpr Array<u8, 16> SPREAD = {1, 0, 2, 1, 4, 3, 5, 4, 7, 6, 8, 7, 10, 9, 11, 10};
+
+    // Each u32 lane now holds one input triple as b1 | b0 << 8 | b2 << 16 | b1 << 24, which puts
+    // every 6-bit field a fixed shift away from its output byte
+    const auto triples = hn::BitCast(d32, hn::TableLookupBytes(hn::LoadU(d, src), hn::Load(d, SPREAD.data())));
+    const auto c0 = hn::And(hn::ShiftRight<10>(triples), hn::Set(d32, 0x0000003Fu));
+    const auto c1 = hn::And(hn::ShiftLeft<4>(triples), hn::Set(d32, 0x00003F00u));
+    const auto c2 = hn::And(hn::ShiftRight<6>(triples), hn::Set(d32, 0x003F0000u));
+    const auto c3 = hn::And(hn::ShiftLeft<8>(triples), hn::Set(d32, 0x3F000000u));
+    const auto values = hn::BitCast(d, hn::Or(hn::Or(c0, c1), hn::Or(c2, c3)));
+
+    // Range per value: 0 for 26..51, 1..12 for 52..63 (saturating), 13 for 0..25
+    const auto ranges = hn::Or(hn::SaturatedSub(values, hn::Set(d, 51)),
+                               hn::IfThenElseZero(hn::Lt(values, hn::Set(d, 26)), hn::Set(d, 13)));
+    const auto offsets = hn::TableLookupBytes(hn::Load(d, tables.encode_offsets.data()), ranges);
+
+    hn::StoreU(hn::Add(values, offsets), d, dst);
   }
 
-  auto StringOps::encode_base64(const Span<const u8> data) -> String
+  // Decodes src[0..16) into dst[0..12), writing 16 bytes. Returns false, leaving `dst` untouched,
+  // if any character is outside the alphabet.
+  static auto decode_base64_block(const u8 *src, Mut<u8 *> dst, Ref<Base64Tables> tables) -> bool
   {
-    Mut<String> result;
-    result.reserve(((data.size() + 2) / 3) * 4);
+    const Base64Tag d;
+    const Base64Tag16 d16;
+    const Base64Tag32 d32;
+
+    const auto chars = hn::LoadU(d, src);
+    const auto hi_nibbles = hn::ShiftRight<4>(chars);
+    const auto lo_nibbles = hn::And(chars, hn::Set(d, 0x0F));
 
-    for (Mut<usize> i = 0; i < data.size(); i += 3)
+    const auto invalid = hn::And(hn::TableLookupBytes(hn::Load(d, tables.invalid_by_lo.data()), lo_nibbles),
+                                 hn::TableLookupBytes(hn::Load(d, tables.bit_by_hi.data()), hi_nibbles));
+    if (!hn::AllFalse(d, hn::Ne(invalid, hn::Zero(d))))
     {
-      const u32 b0 = data[i];
-      const u32 b1 = (i + 1 < data.size()) ? data[i + 1] : 0;
-      const u32 b2 = (i + 2 < data.size()) ? data[i + 2] : 0;
+      return false;
+    }
 
-      const u32 triple = (b0 << 16) | (b1 << 8) | b2;
+    Mut<hn::Vec<Base64Tag>> values =
+        hn::Add(chars, hn::TableLookupBytes(hn::Load(d, tables.roll_by_hi.data()), hi_nibbles));
+    values = hn::IfThenElse(hn::Eq(chars, hn::Set(d, tables.char_62)), hn::Set(d, 62), values);
+    values = hn::IfThenElse(hn::Eq(chars, hn::Set(d, tables.char_63)), hn::Set(d, 63), values);
 
-      result += BASE64_CHAR_TABLE[(triple >> 18) & 0x3F];
-      result += BASE64_CHAR_TABLE[(triple >> 12) & 0x3F];
+    // Merge pairs of 6-bit values into 12 bits, then pairs of those into 24, leaving each output
+    // triple byte-reversed in the low three bytes of a u32 lane
+    const auto pairs = hn::BitCast(d16, values);
+    const auto merged_12 =
+        hn::BitCast(d32, hn::Or(hn::ShiftLeft<6>(hn::And(pairs, hn::Set(d16, 0x00FF))), hn::ShiftRight<8>(pairs)));
+    const auto merged_24 = hn::Or(hn::ShiftLeft<12>(hn::And(merged_12, hn::Set(d32, 0x0000FFFFu))),
+                                  hn::ShiftRight<16>(merged_12));
 
-      if (i + 1 < data.size())
-      {
-        result += BASE64_CHAR_TABLE[(triple >> 6) & 0x3F];
-      }
-      else
+    alignas(16) static constexpr Array<u8, 16> GATHER = {2,    1,    0,    6,    5,    4,    10,   9,
+                                                         8,    14,   13,   12,   0x80, 0x80, 0x80, 0x80};
+    hn::StoreU(hn::TableLookupBytesOr0(hn::BitCast(d, merged_24), hn::Load(d, GATHER.data())), d, dst);
+    return true;
+  }
+
+  // Decodes whole blocks of 16 characters for as long as they are valid and `dst` has room for
+  // the 16 byte store. Returns the number of characters consumed (a multiple of 16).
+  static auto decode_base64_blocks(Ref<Span<const u8>> src, Ref<Span<u8>> dst, Ref<Base64Tables> tables) -> usize
+  {
+    Mut<usize> consumed = 0;
+    Mut<usize> written = 0;
+    while (consumed + 16 <= src.size() && written + 16 <= dst.size() &&
+           decode_base64_block(src.data() + consumed, dst.data() + written, tables))
+    {
+      consumed += 16;
+      written += 12;
+    }
+    return consumed;
+  }
+
+  auto StringOps::encode_base64(const Span<const u8> data) -> String
+  {
+    return encode_base64(data, Base64Alphabet::Standard, true);
+  }
+
+  auto StringOps::encode_base64(const Span<const u8> data, const Base64Alphabet alphabet, const bool pad) -> String
+  {
+    Ref<Base64Tables> tables = base64_tables(alphabet);
+
+    const usize tail = data.size() % 3;
+    const usize out_size = (data.size() / 3) * 4 + (tail == 0 ? 0 : (pad ? 4 : tail + 1));
+
+    Mut<String> result;
+    result.resize_and_overwrite(out_size, [&](Mut<char *> out, const usize) {
+      Mut<u8 *> dst = reinterpret_cast<u8 *>(out);
+      Mut<usize> i = 0;
+
+      for (; i + 16 <= data.size(); i += 12, dst += 16)
       {
-        result += '=';
+        encode_base64_block(data.data() + i, dst, tables);
       }
 
-      if (i + 2 < data.size())
+      for (; i + 3 <= data.size(); i += 3, dst += 4)
       {
-        result += BASE64_CHAR_TABLE[triple & 0x3F];
+        const u32 triple = static_cast<u32>(data[i]) << 16 | static_cast<u32>(data[i + 1]) << 8 | data[i + 2];
+        dst[0] = static_cast<u8>(tables.alphabet[triple >> 18]);
+        dst[1] = static_cast<u8>(tables.alphabet[(triple >> 12) & 0x3F]);
+        dst[2] = static_cast<u8>(tables.alphabet[(triple >> 6) & 0x3F]);
+        dst[3] = static_cast<u8>(tables.alphabet[triple & 0x3F]);
       }
-      else
+
+      if (tail > 0)
       {
-        result += '=';
+        const u32 b1 = tail == 2 ? data[i + 1] : 0;
+        const u32 triple = static_cast<u32>(data[i]) << 16 | b1 << 8;
+        *dst++ = static_cast<u8>(tables.alphabet[triple >> 18]);
+        *dst++ = static_cast<u8>(tables.alphabet[(triple >> 12) & 0x3F]);
+        if (tail == 2)
+        {
+          *dst++ = static_cast<u8>(tables.alphabet[(triple >> 6) & 0x3F]);
+        }
+        if (pad)
+        {
+          *dst++ = '=';
+          if (tail == 1)
+          {
+            *dst++ = '=';
+          }
+        }
       }
-    }
+
+      return out_size;
+    });
     return result;
   }
 
   auto StringOps::decode_base64(Ref<String> data) -> Vec<u8>
   {
+    Ref<Base64Tables> tables = BASE64_STANDARD_TABLES;
+    const Span<const u8> src(reinterpret_cast<const u8 *>(data.data()), data.size());
+
     Mut<Vec<u8>> result;
-    result.reserve(data.size() * 3 / 4);
+    result.resize(data.size() / 4 * 3 + 3);
 
-    Mut<i32> i = 0;
-    Mut<Array<u8, 4>> tmp_buf = {};
+    // Decoding stops at the first character outside the alphabet ('=' included)
+    Mut<usize> i = decode_base64_blocks(src, result, tables);
+    Mut<usize> written = i / 4 * 3;
 
-    for (const char c_char : data)
+    Mut<u32> quad = 0;
+    Mut<u32> count = 0;
+    for (; i < src.size(); ++i)
     {
-      const u8 c = static_cast<u8>(c_char);
-      if (c == '=')
+      const u8 value = tables.decode[src[i]];
+      if (value == BASE64_INVALID)
       {
         break;
       }
-      if (!is_base64(c))
+
+      quad = quad << 6 | value;
+      if (++count == 4)
       {
-        break;
+        result[written++] = static_cast<u8>(quad >> 16);
+        result[written++] = static_cast<u8>(quad >> 8);
+        result[written++] = static_cast<u8>(quad);
+        quad = 0;
+        count = 0;
       }
+    }
 
-      tmp_buf[i++] = c;
-      if (i == 4)
+    if (count > 1)
+    {
+      quad <<= 6 * (4 - count);
+      result[written++] = static_cast<u8>(quad >> 16);
+      if (count > 2)
       {
-        const u8 n0 = get_base64_index(tmp_buf[0]);
-        const u8 n1 = get_base64_index(tmp_buf[1]);
-        const u8 n2 = get_base64_index(tmp_buf[2]);
-        const u8 n3 = get_base64_index(tmp_buf[3]);
+        result[written++] = static_cast<u8>(quad >> 8);
+      }
+    }
 
-        result.push_back((n0 << 2) | ((n1 & 0x30) >> 4));
-        result.push_back(((n1 & 0x0F) << 4) | ((n2 & 0x3C) >> 2));
-        result.push_back(((n2 & 0x03) << 6) | n3);
+    result.resize(written);
+    return result;
+  }
 
-        i = 0;
-      }
+  auto StringOps::decode_base64(Ref<String> data, const Base64Alphabet alphabet) -> Result<Vec<u8>>
+  {
+    Ref<Base64Tables> tables = base64_tables(alphabet);
+
+    Mut<usize> length = data.size();
+    if (length % 4 == 0 && length > 0 && data[length - 1] == '=')
+    {
+      length -= data[length - 2] == '=' ? 2 : 1;
     }
+    if (length % 4 == 1)
+    {
+      return fail("Invalid base64 length {}", data.size());
+    }
+
+    const Span<const u8> src(reinterpret_cast<const u8 *>(data.data()), length);
+    const usize tail = length % 4;
+
+    Mut<Vec<u8>> result;
+    result.resize(length / 4 * 3 + (tail == 0 ? 0 : tail - 1));
+
+    Mut<usize> i = decode_base64_blocks(src, result, tables);
+    Mut<usize> written = i / 4 * 3;
 
-    if (i > 0)
+    Mut<u32> quad = 0;
+    Mut<u32> count = 0;
+    for (; i < src.size(); ++i)
     {
-      for (Mut<i32> j = i; j < 4; ++j)
+      const u8 value = tables.decode[src[i]];
+      if (value == BASE64_INVALID)
       {
-        tmp_buf[j] = 'A';
+        return fail("Invalid base64 character at offset {}", i);
       }
 
-      const u8 n0 = get_base64_index(tmp_buf[0]);
-      const u8 n1 = get_base64_index(tmp_buf[1]);
-      const u8 n2 = get_base64_index(tmp_buf[2]);
+      quad = quad << 6 | value;
+      if (++count == 4)
+      {
+        result[written++] = static_cast<u8>(quad >> 16);
+        result[written++] = static_cast<u8>(quad >> 8);
+        result[written++] = static_cast<u8>(quad);
+        quad = 0;
+        count = 0;
+      }
+    }
 
-      if (i > 1)
+    if (count > 0)
+    {
+      // Canonical encodings leave the bits below the last whole byte zero
+      const u32 spare_bits = count == 2 ? 4 : 2;
+      if (quad & ((1u << spare_bits) - 1))
       {
-        result.push_back((n0 << 2) | ((n1 & 0x30) >> 4));
+        return fail("Invalid base64: non-zero trailing bits");
       }
-      if (i > 2)
+
+      quad <<= 6 * (4 - count);
+      result[written++] = static_cast<u8>(quad >> 16);
+      if (count == 3)
       {
-        result.push_back(((n1 & 0x0F) << 4) | ((n2 & 0x3C) >> 2));
+        result[written++] = static_cast<u8>(quad >> 8);
       }
     }
 
     return result;
   }
 
-} // namespace IACore
\ No newline at end of file
+} // namespace IACore
@@ -13,6 +13,7 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <IACore/SIMD.hpp>
 #include <IACore/Utils.hpp>
 #include <chrono>
 #include <cstdlib>
@@ -21,21 +22,89 @@ namespace IACore
 {
   namespace
   {
-    auto from_hex_char(const char c) -> i32
+    constexpr const u8 HEX_INVALID = 0xFF;
+
+    constexpr auto make_hex_decode_table() -> Array<u8, 256>
     {
-      if (c >= '0' && c <= '9')
+      Mut<Array<u8, 256>> table{};
+      for (MutRef<u8> entry : table)
+      {
+        entry = HEX_INVALID;
+      }
+      for (Mut<u8> i = 0; i < 10; ++i)
       {
-        return c - '0';
+        table['0' + i] = i;
       }
-      if (c >= 'A' && c <= 'F')
+      for (Mut<u8> i = 0; i < 6; ++i)
       {
-        return c - 'A' + 10;
+        table['A' + i] = static_cast<u8>(10 + i);
+        table['a' + i] = static_cast<u8>(10 + i);
       }
-      if (c >= 'a' && c <= 'f')
+      return table;
+    }
+
+    constexpr const Array<u8, 256> HEX_DECODE_TABLE = make_hex_decode_table();
+
+    alignas(16) constexpr const Array<u8, 16> HEX_UPPER_DIGITS = {'0', '1', '2', '3', '4', '5', '6', '7',
+                                                                  '8', '9', 'A', 'B', 'C', 'D', 'E', 'F'};
+    alignas(16) constexpr const Array<u8, 16> HEX_LOWER_DIGITS = {'0', '1', '2', '3', '4', '5', '6', '7',
+                                                                  '8', '9', 'a', 'b', 'c', 'd', 'e', 'f'};
+
+    using HexTag = hn::FixedTag<u8, 16>;
+    using HexTag16 = hn::Repartition<u16, HexTag>;
+
+    // 16 bytes -> 32 characters
+    auto encode_hex_block(const u8 *src, Mut<u8 *> dst, const u8 *digits) -> void
+    {
+      const HexTag d;
+      const auto bytes = hn::LoadU(d, src);
+      const auto lut = hn::Load(d, digits);
+      const auto hi = hn::TableLookupBytes(lut, hn::ShiftRight<4>(bytes));
+      const auto lo = hn::TableLookupBytes(lut, hn::And(bytes, hn::Set(d, 0x0F)));
+
+      hn::StoreU(hn::InterleaveLower(d, hi, lo), d, dst);
+      hn::StoreU(hn::InterleaveUpper(d, hi, lo), d, dst + 16);
+    }
+
+    // Nibble value of each of 16 characters. Sets `valid` to false if any isn't a hex digit.
+    auto decode_hex_nibbles(const u8 *src, MutRef<bool> valid) -> hn::Vec<HexTag>
+    {
+      const HexTag d;
+      const auto chars = hn::LoadU(d, src);
+
+      // Out-of-range characters wrap around to large unsigned values
+      const auto digit = hn::Sub(chars, hn::Set(d, '0'));
+      const auto letter = hn::Sub(hn::Or(chars, hn::Set(d, 0x20)), hn::Set(d, 'a'));
+      const auto is_digit = hn::Lt(digit, hn::Set(d, 10));
+      const auto is_letter = hn::Lt(letter, hn::Set(d, 6));
+
+      valid = valid && hn::AllTrue(d, hn::Or(is_digit, is_letter));
+      return hn::IfThenElse(is_digit, digit, hn::Add(letter, hn::Set(d, 10)));
+    }
+
+    // 32 characters -> 16 bytes. Returns false, leaving `dst` untouched, on a non-hex character.
+    auto decode_hex_block(const u8 *src, Mut<u8 *> dst) -> bool
+    {
+      const HexTag d;
+      const HexTag16 d16;
+
+      Mut<bool> valid = true;
+      const auto first = hn::BitCast(d16, decode_hex_nibbles(src, valid));
+      const auto second = hn::BitCast(d16, decode_hex_nibbles(src + 16, valid));
+      if (!valid)
       {
-        return c - 'a' + 10;
+        return false;
       }
-      return -1;
+
+      // Each u16 lane holds (high nibble, low nibble), merge into its low byte then pack the low bytes
+      const auto merge = [&](const hn::Vec<HexTag16> pairs) {
+        const auto bytes = hn::Or(hn::ShiftLeft<4>(hn::And(pairs, hn::Set(d16, 0x00FF))), hn::ShiftRight<8>(pairs));
+        alignas(16) static constexpr Array<u8, 16> EVEN_BYTES = {0, 2, 4, 6, 8, 10, 12, 14, 0, 2, 4, 6, 8, 10, 12, 14};
+        return hn::TableLookupBytes(hn::BitCast(d, bytes), hn::Load(d, EVEN_BYTES.data()));
+      };
+
+      hn::StoreU(hn::ConcatLowerLower(d, merge(second), merge(first)), d, dst);
+      return true;
     }
   } // namespace
 
@@ -83,44 +152,84 @@ namespace IACore
 
   auto Utils::binary_to_hex_string(const Span<const u8> data) -> String
   {
-    static constexpr const char LUT[17] = "0123456789ABCDEF";
-    Mut<String> res = String();
-    res.reserve(data.size() * 2);
+    return binary_to_hex_string(data, HexCase::Upper);
+  }
+
+  auto Utils::binary_to_hex_string(const Span<const u8> data, const HexCase letter_case) -> String
+  {
+    Mut<String> res;
+    res.resize_and_overwrite(data.size() * 2, [&](Mut<char *> out, const usize size) {
+      return binary_to_hex(data, Span<char>(out, size), letter_case).value_or(0);
+    });
+    return res;
+  }
 
-    for (u8 b : data)
+  auto Utils::binary_to_hex(const Span<const u8> data, const Span<char> out, const HexCase letter_case)
+      -> Result<usize>
+  {
+    if (out.size() < data.size() * 2)
     {
-      res.push_back(LUT[(b >> 4) & 0x0F]);
-      res.push_back(LUT[b & 0x0F]);
+      return fail("Hex output needs {} characters, buffer holds {}", data.size() * 2, out.size());
     }
-    return res;
+
+    const u8 *digits = letter_case == HexCase::Lower ? HEX_LOWER_DIGITS.data() : HEX_UPPER_DIGITS.data();
+    Mut<u8 *> dst = reinterpret_cast<u8 *>(out.data());
+
+    Mut<usize> i = 0;
+    for (; i + 16 <= data.size(); i += 16, dst += 32)
+    {
+      encode_hex_block(data.data() + i, dst, digits);
+    }
+    for (; i < data.size(); ++i)
+    {
+      *dst++ = digits[data[i] >> 4];
+      *dst++ = digits[data[i] & 0x0F];
+    }
+
+    return data.size() * 2;
   }
 
   auto Utils::hex_string_to_binary(const StringView hex) -> Result<Vec<u8>>
+  {
+    Mut<Vec<u8>> out;
+    out.resize(hex.size() / 2);
+
+    AU_TRY_PURE(hex_to_binary(hex, out));
+    return out;
+  }
+
+  auto Utils::hex_to_binary(const StringView hex, const Span<u8> out) -> Result<usize>
   {
     if (hex.size() % 2 != 0)
     {
       return fail("Hex string must have even length");
     }
+    if (out.size() < hex.size() / 2)
+    {
+      return fail("Binary output needs {} bytes, buffer holds {}", hex.size() / 2, out.size());
+    }
 
-    Mut<Vec<u8>> out = Vec<u8>();
-    out.reserve(hex.size() / 2);
+    const u8 *src = reinterpret_cast<const u8 *>(hex.data());
 
-    for (Mut<usize> i = 0; i < hex.size(); i += 2)
+    Mut<usize> i = 0;
+    while (i + 32 <= hex.size() && decode_hex_block(src + i, out.data() + i / 2))
     {
-      const char high = hex[i];
-      const char low = hex[i + 1];
+      i += 32;
+    }
 
-      const i32 h = from_hex_char(high);
-      const i32 l = from_hex_char(low);
+    for (; i < hex.size(); i += 2)
+    {
+      const u8 h = HEX_DECODE_TABLE[src[i]];
+      const u8 l = HEX_DECODE_TABLE[src[i + 1]];
 
-      if (h == -1 || l == -1)
+      if (h == HEX_INVALID || l == HEX_INVALID)
       {
         return fail("Invalid hex character found");
       }
 
-      out.push_back(static_cast<u8>((h << 4) | l));
+      out[i / 2] = static_cast<u8>((h << 4) | l);
     }
 
-    return out;
+    return hex.size() / 2;
   }
 } // namespace IACore
\ No newline at end of file
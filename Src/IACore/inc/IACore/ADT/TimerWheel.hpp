@@ -0,0 +1,414 @@
+// IACore-OSS; The Core Library for All IA Open Source Projects
+// Copyright (C) 2026 IAS (ias@iasoft.dev)
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <IACore/PCH.hpp>
+
+namespace IACore
+{
+  // Hierarchical (cascading) timer wheel. Insert and cancel are O(1), advancing costs
+  // O(expired timers) plus an occasional cascade of one higher level slot.
+  //
+  // Level 0 resolves single ticks over 256 slots, each higher level covers 64 slots of the
+  // level below, giving 2^26 ticks of range. Timers beyond that range are parked in the
+  // last level and re-bucketed as the wheel turns.
+  //
+  // Not thread-safe, the owner is expected to serialize access.
+  template<typename T> class TimerWheel
+  {
+public:
+    using TimerId = u64;
+
+    static constexpr const TimerId INVALID_TIMER_ID = 0;
+
+    explicit TimerWheel(const u64 start_tick = 0);
+
+    // Timers that are already due fire on the next advance
+    auto schedule(const u64 expiry_tick, ForwardRef<T> payload) -> TimerId;
+
+    // Returns the payload of the cancelled timer, nullopt if it already fired or was cancelled
+    auto cancel(const TimerId id) -> Option<T>;
+
+    // Fires every timer with expiry <= now_tick, in tick order.
+    // `on_expire(TimerId, MutRef<T>) -> Option<u64>` may return a new expiry tick to re-arm the
+    // timer under the same id, otherwise the timer is released. It must not schedule or cancel
+    // timers on this wheel itself.
+    template<typename F> auto advance(const u64 now_tick, ForwardRef<F> on_expire) -> usize;
+
+    // Earliest tick at which advance() has work to do (a due slot or a cascade), nullopt when empty
+    [[nodiscard]] auto next_event_tick() const -> Option<u64>;
+
+    // Releases every pending timer, handing each payload to `on_drop(MutRef<T>)` first
+    template<typename F> auto drain(ForwardRef<F> on_drop) -> void;
+
+    [[nodiscard]] auto current_tick() const -> u64
+    {
+      return m_current_tick;
+    }
+
+    [[nodiscard]] auto size() const -> usize
+    {
+      return m_count;
+    }
+
+    [[nodiscard]] auto empty() const -> bool
+    {
+      return m_count == 0;
+    }
+
+private:
+    static constexpr const u32 NIL = 0xFFFFFFFF;
+
+    static constexpr const u32 LEVEL0_BITS = 8;
+    static constexpr const u32 LEVELN_BITS = 6;
+    static constexpr const u32 LEVEL_COUNT = 4;
+
+    static constexpr const u32 LEVEL0_SLOTS = 1u << LEVEL0_BITS;
+    static constexpr const u32 LEVELN_SLOTS = 1u << LEVELN_BITS;
+    static constexpr const u32 TOTAL_SLOTS = LEVEL0_SLOTS + (LEVEL_COUNT - 1) * LEVELN_SLOTS;
+
+    static constexpr const u64 MAX_DELTA = 1ull << (LEVEL0_BITS + (LEVEL_COUNT - 1) * LEVELN_BITS);
+
+    struct Node
+    {
+      Mut<Option<T>> payload;
+      Mut<u64> expiry_tick{};
+      Mut<u32> prev{NIL};
+      Mut<u32> next{NIL};
+      Mut<u32> generation{1};
+      Mut<u32> slot{NIL};
+    };
+
+    Mut<Vec<Node>> m_nodes;
+    Mut<Array<u32, TOTAL_SLOTS>> m_slot_heads;
+    Mut<u32> m_free_head{NIL};
+    Mut<u64> m_current_tick{};
+    Mut<usize> m_count{};
+
+private:
+    static auto level_shift(const u32 level) -> u32
+    {
+      return level == 0 ? 0 : LEVEL0_BITS + (level - 1) * LEVELN_BITS;
+    }
+
+    static auto slot_base(const u32 level) -> u32
+    {
+      return level == 0 ? 0 : LEVEL0_SLOTS + (level - 1) * LEVELN_SLOTS;
+    }
+
+    static auto slot_mask(const u32 level) -> u64
+    {
+      return level == 0 ? LEVEL0_SLOTS - 1 : LEVELN_SLOTS - 1;
+    }
+
+    static auto make_id(const u32 index, const u32 generation) -> TimerId
+    {
+      return (static_cast<u64>(generation) << 32) | static_cast<u64>(index + 1);
+    }
+
+    auto resolve(const TimerId id) const -> u32;
+
+    auto allocate_node() -> u32;
+    auto release_node(const u32 index) -> void;
+
+    // Timers due before `earliest_tick` are bucketed at `earliest_tick`
+    auto link(const u32 index, const u64 earliest_tick) -> void;
+    auto unlink(const u32 index) -> void;
+
+    auto cascade(const u32 level) -> void;
+  };
+
+  template<typename T> inline TimerWheel<T>::TimerWheel(const u64 start_tick) : m_current_tick(start_tick)
+  {
+    m_slot_heads.fill(NIL);
+  }
+
+  template<typename T> inline auto TimerWheel<T>::schedule(const u64 expiry_tick, ForwardRef<T> payload) -> TimerId
+  {
+    const u32 index = allocate_node();
+    MutRef<Node> node = m_nodes[index];
+    node.payload.emplace(std::move(payload));
+    node.expiry_tick = expiry_tick;
+
+    link(index, m_current_tick + 1);
+    m_count++;
+
+    return make_id(index, node.generation);
+  }
+
+  template<typename T> inline auto TimerWheel<T>::cancel(const TimerId id) -> Option<T>
+  {
+    const u32 index = resolve(id);
+    if (index == NIL)
+    {
+      return std::nullopt;
+    }
+
+    unlink(index);
+    Mut<Option<T>> payload = std::move(m_nodes[index].payload);
+    release_node(index);
+    m_count--;
+
+    return payload;
+  }
+
+  template<typename T>
+  template<typename F>
+  inline auto TimerWheel<T>::advance(const u64 now_tick, ForwardRef<F> on_expire) -> usize
+  {
+    Mut<usize> fired = 0;
+
+    while (m_current_tick < now_tick)
+    {
+      // Jump straight to the next tick that has work instead of walking empty ones
+      const Option<u64> next_tick = next_event_tick();
+      if (!next_tick || *next_tick > now_tick)
+      {
+        m_current_tick = now_tick;
+        break;
+      }
+      m_current_tick = *next_tick;
+
+      // Cascade top-down so timers moving down multiple levels land before their slot is read
+      Mut<u32> cascade_levels = 0;
+      while (cascade_levels < LEVEL_COUNT - 1 &&
+             ((m_current_tick >> level_shift(cascade_levels)) & slot_mask(cascade_levels)) == 0)
+      {
+        cascade_levels++;
+      }
+      for (Mut<u32> level = cascade_levels; level > 0; --level)
+      {
+        cascade(level);
+      }
+
+      const u32 slot = static_cast<u32>(m_current_tick & slot_mask(0));
+      Mut<u32> index = m_slot_heads[slot];
+      m_slot_heads[slot] = NIL;
+
+      while (index != NIL)
+      {
+        const u32 next = m_nodes[index].next;
+        m_nodes[index].prev = NIL;
+        m_nodes[index].next = NIL;
+        m_nodes[index].slot = NIL;
+
+        if (m_nodes[index].expiry_tick > m_current_tick)
+        {
+          link(index, m_current_tick + 1);
+          index = next;
+          continue;
+        }
+
+        const Option<u64> rearm_tick = on_expire(make_id(index, m_nodes[index].generation), *m_nodes[index].payload);
+        fired++;
+
+        if (rearm_tick)
+        {
+          m_nodes[index].expiry_tick = *rearm_tick;
+          link(index, m_current_tick + 1);
+        }
+        else
+        {
+          release_node(index);
+          m_count--;
+        }
+
+        index = next;
+      }
+    }
+
+    return fired;
+  }
+
+  template<typename T> inline auto TimerWheel<T>::next_event_tick() const -> Option<u64>
+  {
+    if (m_count == 0)
+    {
+      return std::nullopt;
+    }
+
+    Mut<u64> earliest = std::numeric_limits<u64>::max();
+
+    // Level 0 only ever holds timers due within the next LEVEL0_SLOTS ticks
+    for (Mut<u32> slot = 0; slot < LEVEL0_SLOTS; ++slot)
+    {
+      if (m_slot_heads[slot] != NIL)
+      {
+        Mut<u64> delta = (slot - m_current_tick) & slot_mask(0);
+        if (delta == 0)
+        {
+          delta = LEVEL0_SLOTS;
+        }
+        earliest = std::min(earliest, m_current_tick + delta);
+      }
+    }
+
+    // Higher level slots matter at the tick they cascade down
+    for (Mut<u32> level = 1; level < LEVEL_COUNT; ++level)
+    {
+      const u32 shift = level_shift(level);
+      const u64 next_bucket = (m_current_tick >> shift) + 1;
+
+      for (Mut<u32> slot = 0; slot < LEVELN_SLOTS; ++slot)
+      {
+        if (m_slot_heads[slot_base(level) + slot] != NIL)
+        {
+          const u64 bucket = next_bucket + ((slot - next_bucket) & slot_mask(level));
+          earliest = std::min(earliest, bucket << shift);
+        }
+      }
+    }
+
+    return earliest;
+  }
+
+  template<typename T> template<typename F> inline auto TimerWheel<T>::drain(ForwardRef<F> on_drop) -> void
+  {
+    for (Mut<u32> slot = 0; slot < TOTAL_SLOTS; ++slot)
+    {
+      Mut<u32> index = m_slot_heads[slot];
+      m_slot_heads[slot] = NIL;
+
+      while (index != NIL)
+      {
+        const u32 next = m_nodes[index].next;
+        on_drop(*m_nodes[index].payload);
+        release_node(index);
+        index = next;
+      }
+    }
+
+    m_count = 0;
+  }
+
+  template<typename T> inline auto TimerWheel<T>::resolve(const TimerId id) const -> u32
+  {
+    const u64 low = id & 0xFFFFFFFF;
+    if (low == 0 || low > m_nodes.size())
+    {
+      return NIL;
+    }
+
+    const u32 index = static_cast<u32>(low - 1);
+    Ref<Node> node = m_nodes[index];
+    if (node.generation != static_cast<u32>(id >> 32) || !node.payload)
+    {
+      return NIL;
+    }
+
+    return index;
+  }
+
+  template<typename T> inline auto TimerWheel<T>::allocate_node() -> u32
+  {
+    if (m_free_head != NIL)
+    {
+      const u32 index = m_free_head;
+      m_free_head = m_nodes[index].next;
+      m_nodes[index].next = NIL;
+      return index;
+    }
+
+    m_nodes.emplace_back();
+    return static_cast<u32>(m_nodes.size() - 1);
+  }
+
+  template<typename T> inline auto TimerWheel<T>::release_node(const u32 index) -> void
+  {
+    MutRef<Node> node = m_nodes[index];
+    node.payload.reset();
+    node.generation++;
+    if (node.generation == 0)
+    {
+      node.generation = 1;
+    }
+    node.prev = NIL;
+    node.slot = NIL;
+    node.next = m_free_head;
+    m_free_head = index;
+  }
+
+  template<typename T> inline auto TimerWheel<T>::link(const u32 index, const u64 earliest_tick) -> void
+  {
+    MutRef<Node> node = m_nodes[index];
+
+    const u64 expiry = std::max(node.expiry_tick, earliest_tick);
+    Mut<u64> delta = expiry - m_current_tick;
+    Mut<u64> bucket_tick = expiry;
+    if (delta >= MAX_DELTA)
+    {
+      delta = MAX_DELTA - 1;
+      bucket_tick = m_current_tick + delta;
+    }
+
+    Mut<u32> level = 0;
+    while (level < LEVEL_COUNT - 1 && delta >= (1ull << level_shift(level + 1)))
+    {
+      level++;
+    }
+
+    const u32 slot = slot_base(level) + static_cast<u32>((bucket_tick >> level_shift(level)) & slot_mask(level));
+
+    node.slot = slot;
+    node.prev = NIL;
+    node.next = m_slot_heads[slot];
+    if (node.next != NIL)
+    {
+      m_nodes[node.next].prev = index;
+    }
+    m_slot_heads[slot] = index;
+  }
+
+  template<typename T> inline auto TimerWheel<T>::unlink(const u32 index) -> void
+  {
+    MutRef<Node> node = m_nodes[index];
+
+    if (node.prev != NIL)
+    {
+      m_nodes[node.prev].next = node.next;
+    }
+    else if (node.slot != NIL)
+    {
+      m_slot_heads[node.slot] = node.next;
+    }
+
+    if (node.next != NIL)
+    {
+      m_nodes[node.next].prev = node.prev;
+    }
+
+    node.prev = NIL;
+    node.next = NIL;
+    node.slot = NIL;
+  }
+
+  template<typename T> inline auto TimerWheel<T>::cascade(const u32 level) -> void
+  {
+    const u32 slot = slot_base(level) + static_cast<u32>((m_current_tick >> level_shift(level)) & slot_mask(level));
+
+    Mut<u32> index = m_slot_heads[slot];
+    m_slot_heads[slot] = NIL;
+
+    while (index != NIL)
+    {
+      const u32 next = m_nodes[index].next;
+      m_nodes[index].prev = NIL;
+      m_nodes[index].next = NIL;
+      link(index, m_current_tick);
+      index = next;
+    }
+  }
+} // namespace IACore
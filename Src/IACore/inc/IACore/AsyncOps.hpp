@@ -15,7 +15,9 @@
 
 #pragma once
 
+#include <IACore/ADT/TimerWheel.hpp>
 #include <IACore/PCH.hpp>
+#include <chrono>
 #include <deque>
 #include <functional>
 #include <stop_token>
@@ -25,10 +27,14 @@ namespace IACore
   class AsyncOps
   {
 public:
+    class Scheduler;
+
     using TaskTag = u64;
     using WorkerId = u16;
+    using TimerHandle = u64;
 
     static constexpr const WorkerId MAIN_THREAD_WORKER_ID = 0;
+    static constexpr const TimerHandle INVALID_TIMER_HANDLE = 0;
 
     enum class Priority : u8
     {
@@ -41,7 +47,48 @@ public:
       Mut<std::atomic<i32>> counter{0};
     };
 
+    struct WorkerStats
+    {
+      Mut<u64> tasks_run{};
+      Mut<u64> busy_ns{};
+      Mut<u64> idle_ns{};
+      Mut<u64> lock_contentions{};       // Times the worker found the shared queue lock already held
+      Mut<u64> queue_depth_high_water{}; // Deepest queue (both priorities) observed when popping a task
+    };
+
+    struct TraceEvent
+    {
+      Mut<TaskTag> tag{};
+      Mut<WorkerId> worker_id{};
+      Mut<u64> begin_ns{};
+      Mut<u64> end_ns{};
+    };
+
+    static constexpr const usize DEFAULT_TRACE_CAPACITY = 16384;
+
+    struct SchedulerConfig
+    {
+      Mut<u8> worker_count{0}; // 0 picks hardware_concurrency - 2 (at least 2)
+      Mut<String> name{"Worker"};
+
+      // Worker N is pinned to pinned_cpus[(N - 1) % size], empty leaves placement to the OS
+      Mut<Vec<u32>> pinned_cpus{};
+    };
+
+    // Pool behind run_task, kept apart from the compute workers so blocking calls can't starve them.
+    // Threads are started on demand up to `max_threads`; once more than `core_threads` exist, threads
+    // idle for `idle_timeout_ms` exit. Tasks beyond `max_threads` wait in a FIFO queue.
+    struct BlockingPoolConfig
+    {
+      Mut<u32> core_threads{0};
+      Mut<u32> max_threads{64};
+      Mut<u64> idle_timeout_ms{10000};
+    };
+
 public:
+    // The static scheduling API below drives this process-wide instance
+    static auto default_scheduler() -> MutRef<Scheduler>;
+
     static auto initialize_scheduler(const u8 worker_count = 0) -> Result<void>;
     static auto terminate_scheduler() -> void;
 
@@ -52,10 +99,90 @@ public:
 
     static auto wait_for_schedule_completion(Mut<Schedule *> schedule) -> void;
 
+    // Runs `task` on the blocking pool, independent of any scheduler
     static auto run_task(Mut<std::function<void()>> task) -> void;
 
+    static auto configure_blocking_pool(Ref<BlockingPoolConfig> config) -> void;
+    IA_NODISCARD static auto get_blocking_pool_thread_count() -> u32;
+
+    // Timers have millisecond resolution. When fired, the task is queued like any other
+    // scheduled task. A one-shot timer counts towards `schedule` (if given) from the moment
+    // it is armed, so wait_for_schedule_completion also waits for pending timers.
+    static auto schedule_after(const u64 delay_ms, Mut<std::function<void(const WorkerId)>> task, const TaskTag tag,
+                               Mut<Schedule *> schedule = nullptr, const Priority priority = Priority::Normal)
+        -> TimerHandle;
+
+    // Fires every `interval_ms` until cancelled. Periods missed while the workers lag behind are skipped.
+    static auto schedule_every(const u64 interval_ms, Mut<std::function<void(const WorkerId)>> task,
+                               const TaskTag tag, const Priority priority = Priority::Normal) -> TimerHandle;
+
+    // Returns false if the timer already fired (one-shot) or was already cancelled
+    static auto cancel_timer(const TimerHandle handle) -> bool;
+
     IA_NODISCARD static auto get_worker_count() -> WorkerId;
 
+    // Index 0 is the main thread (tasks run from wait_for_schedule_completion)
+    IA_NODISCARD static auto get_worker_stats(const WorkerId worker_id) -> WorkerStats;
+    static auto reset_worker_stats() -> void;
+
+    // Each worker records into its own ring of `events_per_worker` entries, oldest events are overwritten
+    static auto enable_tracing(const usize events_per_worker = DEFAULT_TRACE_CAPACITY) -> void;
+    static auto disable_tracing() -> void;
+
+    IA_NODISCARD static auto get_trace_events() -> Vec<TraceEvent>;
+
+    // Chrome trace event format, loadable in chrome://tracing or Perfetto
+    IA_NODISCARD static auto export_chrome_trace() -> String;
+  };
+
+  // An independent worker pool with its own queues, timers and stats. Mirrors the static
+  // AsyncOps API; handles (Schedule, TimerHandle) are only meaningful on the instance that issued them.
+  class AsyncOps::Scheduler
+  {
+public:
+    static auto create(Ref<SchedulerConfig> config) -> Result<Box<Scheduler>>;
+
+    Scheduler() = default;
+    ~Scheduler();
+
+    Scheduler(Ref<Scheduler>) = delete;
+    auto operator=(Ref<Scheduler>) -> MutRef<Scheduler> = delete;
+
+    auto start(Ref<SchedulerConfig> config) -> Result<void>;
+    auto stop() -> void;
+
+    IA_NODISCARD auto is_running() const -> bool
+    {
+      return !m_workers.empty();
+    }
+
+    auto schedule_task(Mut<std::function<void(const WorkerId)>> task, const TaskTag tag, Mut<Schedule *> schedule,
+                       const Priority priority = Priority::Normal) -> void;
+
+    auto cancel_tasks_of_tag(const TaskTag tag) -> void;
+
+    auto wait_for_schedule_completion(Mut<Schedule *> schedule) -> void;
+
+    auto schedule_after(const u64 delay_ms, Mut<std::function<void(const WorkerId)>> task, const TaskTag tag,
+                        Mut<Schedule *> schedule = nullptr, const Priority priority = Priority::Normal)
+        -> TimerHandle;
+
+    auto schedule_every(const u64 interval_ms, Mut<std::function<void(const WorkerId)>> task, const TaskTag tag,
+                        const Priority priority = Priority::Normal) -> TimerHandle;
+
+    auto cancel_timer(const TimerHandle handle) -> bool;
+
+    IA_NODISCARD auto get_worker_count() const -> WorkerId;
+
+    IA_NODISCARD auto get_worker_stats(const WorkerId worker_id) const -> WorkerStats;
+    auto reset_worker_stats() -> void;
+
+    auto enable_tracing(const usize events_per_worker = DEFAULT_TRACE_CAPACITY) -> void;
+    auto disable_tracing() -> void;
+
+    IA_NODISCARD auto get_trace_events() -> Vec<TraceEvent>;
+    IA_NODISCARD auto export_chrome_trace() -> String;
+
 private:
     struct ScheduledTask
     {
@@ -64,13 +191,81 @@ private:
       Mut<std::function<void(const WorkerId)>> task{};
     };
 
-    static auto schedule_worker_loop(Mut<std::stop_token> stop_token, const WorkerId worker_id) -> void;
+    // `sequence` is odd while event N is being written and 2 * N + 2 once it is complete,
+    // so readers can detect slots that were overwritten under them
+    struct TraceSlot
+    {
+      Mut<std::atomic<u64>> sequence{0};
+      Mut<std::atomic<TaskTag>> tag{0};
+      Mut<std::atomic<u64>> begin_ns{0};
+      Mut<std::atomic<u64>> end_ns{0};
+    };
+
+    struct TraceRing
+    {
+      Mut<Vec<TraceSlot>> slots;
+      Mut<std::atomic<u64>> head{0};
+    };
+
+    struct alignas(64) WorkerState
+    {
+      Mut<std::atomic<u64>> tasks_run{0};
+      Mut<std::atomic<u64>> busy_ns{0};
+      Mut<std::atomic<u64>> idle_ns{0};
+      Mut<std::atomic<u64>> lock_contentions{0};
+      Mut<std::atomic<u64>> queue_depth_high_water{0};
+
+      Mut<std::atomic<TraceRing *>> trace_ring{nullptr}; // Owned by m_trace_rings
+    };
+
+    struct TimerEntry
+    {
+      Mut<TaskTag> tag{};
+      Mut<Schedule *> schedule_handle{};
+      Mut<Priority> priority{Priority::Normal};
+      Mut<u64> interval_ms{}; // 0 for one-shot timers
+      Mut<std::function<void(const WorkerId)>> task{};
+    };
+
+    auto worker_loop(Mut<std::stop_token> stop_token, const WorkerId worker_id) -> void;
+    auto timer_loop(Mut<std::stop_token> stop_token) -> void;
+
+    auto arm_timer(const u64 delay_ms, Mut<TimerEntry> entry) -> TimerHandle;
+
+    auto lock_queue(MutRef<WorkerState> state) -> std::unique_lock<std::mutex>;
+
+    // Caller must hold m_queue_mutex
+    auto pop_task_locked(MutRef<WorkerState> state, MutRef<ScheduledTask> out_task) -> bool;
+    auto execute_task(MutRef<WorkerState> state, MutRef<ScheduledTask> task, const WorkerId worker_id) -> void;
+
+    // Caller must hold m_trace_mutex
+    auto install_trace_rings(const usize capacity) -> void;
 
 private:
-    static Mut<std::mutex> s_queue_mutex;
-    static Mut<std::condition_variable> s_wake_condition;
-    static Mut<Vec<std::jthread>> s_schedule_workers;
-    static Mut<std::deque<ScheduledTask>> s_high_priority_queue;
-    static Mut<std::deque<ScheduledTask>> s_normal_priority_queue;
+    Mut<String> m_name{"Worker"};
+
+    Mut<std::mutex> m_queue_mutex;
+    Mut<std::condition_variable> m_wake_condition;
+    Mut<Vec<std::jthread>> m_workers;
+    Mut<std::deque<ScheduledTask>> m_high_priority_queue;
+    Mut<std::deque<ScheduledTask>> m_normal_priority_queue;
+
+    Mut<Vec<Box<WorkerState>>> m_worker_states;
+    Mut<std::atomic<bool>> m_tracing_enabled{false};
+    Mut<std::atomic<u64>> m_trace_epoch_ns{0};
+    Mut<usize> m_trace_capacity{0};
+
+    // Taken by enable_tracing and the exporters, never by the workers. Rings replaced by a
+    // capacity change stay alive until the next start() since a worker may still be writing to them.
+    Mut<std::mutex> m_trace_mutex;
+    Mut<Vec<Box<TraceRing>>> m_trace_rings;
+
+    Mut<std::mutex> m_timer_mutex;
+    Mut<std::condition_variable_any> m_timer_condition;
+    Mut<std::jthread> m_timer_thread;
+    Mut<TimerWheel<TimerEntry>> m_timer_wheel;
+    Mut<std::chrono::steady_clock::time_point> m_timer_epoch;
+    Mut<u64> m_timer_wake_tick{0};
+    Mut<Schedule> m_timer_schedule;
   };
-} // namespace IACore
\ No newline at end of file
+} // namespace IACore
@@ -19,14 +19,48 @@
 
 namespace IACore
 {
+  class StreamWriter;
+
   class DataOps
   {
 public:
+    // Incremental counterparts of the one-shot hashes. Feeding the same bytes through any
+    // sequence of update() calls gives the same digest() as hashing them in one span.
+    class Fnv1aHasher;
+    class XxhashHasher;
+    class Xxhash64Hasher;
+    class Xxh3Hasher;
+    class Crc32Hasher;
+
+    class StreamCompressor;
+    class StreamDecompressor;
+    class ZstdDictionary;
+    class ZstdSeekableReader;
+
     enum class CompressionType
     {
       None,
       Gzip,
-      Zlib
+      Zlib,
+      Zstd,
+      Lz4 // LZ4 frame format
+    };
+
+    struct CompressionOptions
+    {
+      Mut<Option<i32>> level{}; // Codec default when empty (zlib 6, zstd 3, lz4 0; lz4 >= 3 selects LZ4-HC)
+
+      // zstd: internal worker threads (ignored if libzstd lacks multithreading).
+      // gzip: parallel blocks on the AsyncOps workers, if the scheduler is running.
+      Mut<u32> workers{1};
+    };
+
+    struct Hash128
+    {
+      Mut<u64> low{};
+      Mut<u64> high{};
+
+      auto operator==(Ref<Hash128>) const -> bool = default;
     };
 
 public:
@@ -36,17 +70,300 @@ public:
     static auto hash_xxhash(Ref<String> string, const u32 seed = 0) -> u32;
     static auto hash_xxhash(Ref<Span<const u8>> data, const u32 seed = 0) -> u32;
 
+    static auto hash_xxhash64(Ref<String> string, const u64 seed = 0) -> u64;
+    static auto hash_xxhash64(Ref<Span<const u8>> data, const u64 seed = 0) -> u64;
+
+    // XXH3 (xxHash 0.8), vectorized with AVX2 / NEON for inputs above 240 bytes
+    static auto hash_xxh3(Ref<String> string, const u64 seed = 0) -> u64;
+    static auto hash_xxh3(Ref<Span<const u8>> data, const u64 seed = 0) -> u64;
+
+    static auto hash_xxh3_128(Ref<String> string, const u64 seed = 0) -> Hash128;
+    static auto hash_xxh3_128(Ref<Span<const u8>> data, const u64 seed = 0) -> Hash128;
+
+    // CRC32C (Castagnoli)
     static auto crc32(Ref<Span<const u8>> data) -> u32;
 
+    // Continues a checksum, crc32_update(crc32(a), b) == crc32(a + b). Start from 0.
+    static auto crc32_update(const u32 crc, Ref<Span<const u8>> data) -> u32;
+
+    // crc32(a + b) from crc32(a), crc32(b) and the length of b, without touching the data
+    static auto crc32_combine(const u32 crc_a, const u32 crc_b, const u64 length_b) -> u32;
+
     static auto detect_compression(const Span<const u8> data) -> CompressionType;
 
+    // The one-shot codecs reuse a per-thread compression context. The *_into variants write into
+    // `out` and return the number of bytes written, failing if `out` is too small; sized with the
+    // matching *_bound they perform no heap allocation once the thread's context is warm.
     static auto gzip_inflate(Ref<Span<const u8>> data) -> Result<Vec<u8>>;
     static auto gzip_deflate(Ref<Span<const u8>> data) -> Result<Vec<u8>>;
+    static auto gzip_inflate_into(Ref<Span<const u8>> data, Ref<Span<u8>> out) -> Result<usize>;
+    static auto gzip_deflate_into(Ref<Span<const u8>> data, Ref<Span<u8>> out) -> Result<usize>;
+    static auto gzip_deflate_bound(const usize size) -> usize;
 
     static auto zlib_inflate(Ref<Span<const u8>> data) -> Result<Vec<u8>>;
     static auto zlib_deflate(Ref<Span<const u8>> data) -> Result<Vec<u8>>;
+    static auto zlib_inflate_into(Ref<Span<const u8>> data, Ref<Span<u8>> out) -> Result<usize>;
+    static auto zlib_deflate_into(Ref<Span<const u8>> data, Ref<Span<u8>> out) -> Result<usize>;
+    static auto zlib_deflate_bound(const usize size) -> usize;
 
     static auto zstd_inflate(Ref<Span<const u8>> data) -> Result<Vec<u8>>;
     static auto zstd_deflate(Ref<Span<const u8>> data) -> Result<Vec<u8>>;
+    static auto zstd_inflate_into(Ref<Span<const u8>> data, Ref<Span<u8>> out) -> Result<usize>;
+    static auto zstd_deflate_into(Ref<Span<const u8>> data, Ref<Span<u8>> out) -> Result<usize>;
+    static auto zstd_deflate_bound(const usize size) -> usize;
+
+    // LZ4 frames: far faster than zstd to decode (several GB/s) at a lower ratio, for latency
+    // sensitive paths such as IPC payloads and cache entries
+    static auto lz4_inflate(Ref<Span<const u8>> data) -> Result<Vec<u8>>;
+    static auto lz4_deflate(Ref<Span<const u8>> data) -> Result<Vec<u8>>;
+    static auto lz4_inflate_into(Ref<Span<const u8>> data, Ref<Span<u8>> out) -> Result<usize>;
+    static auto lz4_deflate_into(Ref<Span<const u8>> data, Ref<Span<u8>> out) -> Result<usize>;
+    static auto lz4_deflate_bound(const usize size) -> usize;
+
+    static auto lz4_deflate(Ref<Span<const u8>> data, Ref<CompressionOptions> options) -> Result<Vec<u8>>;
+
+    static auto zstd_deflate(Ref<Span<const u8>> data, Ref<CompressionOptions> options) -> Result<Vec<u8>>;
+
+    // With more than one worker, inputs above 1 MiB are compressed as independent blocks (like pigz)
+    // and stitched into a single gzip member readable by any inflater
+    static auto gzip_deflate(Ref<Span<const u8>> data, Ref<CompressionOptions> options) -> Result<Vec<u8>>;
+
+    // Codec dispatch. CompressionType::None passes the data through unchanged; decompress(data)
+    // picks the codec with detect_compression and fails on unrecognized data.
+    static auto compress(const CompressionType type, Ref<Span<const u8>> data) -> Result<Vec<u8>>;
+    static auto compress(const CompressionType type, Ref<Span<const u8>> data, Ref<CompressionOptions> options)
+        -> Result<Vec<u8>>;
+    static auto decompress(Ref<Span<const u8>> data) -> Result<Vec<u8>>;
+    static auto decompress(const CompressionType type, Ref<Span<const u8>> data) -> Result<Vec<u8>>;
+
+    // zstd seekable format (zstd contrib/seekable_format): independent frames of `frame_size` input
+    // bytes followed by a seek table of sizes and XXH64 checksums in a skippable frame, so the result
+    // is still a valid zstd stream. Frames are compressed on the AsyncOps workers when
+    // `options.workers` > 1. Read back with ZstdSeekableReader.
+    static auto zstd_seekable_deflate(Ref<Span<const u8>> data, Ref<CompressionOptions> options,
+                                      const usize frame_size = 1024 * 1024) -> Result<Vec<u8>>;
+
+    // Trains a dictionary (ZDICT) from representative samples, typically a few hundred small records.
+    // `max_size` caps the result, 100 KiB is zstd's recommended default.
+    static auto zstd_train_dictionary(const Span<const Span<const u8>> samples, const usize max_size = 112640)
+        -> Result<Vec<u8>>;
+
+    static auto zstd_inflate(Ref<Span<const u8>> data, Ref<ZstdDictionary> dictionary) -> Result<Vec<u8>>;
+    static auto zstd_deflate(Ref<Span<const u8>> data, Ref<ZstdDictionary> dictionary) -> Result<Vec<u8>>;
+    static auto zstd_inflate_into(Ref<Span<const u8>> data, Ref<Span<u8>> out, Ref<ZstdDictionary> dictionary)
+        -> Result<usize>;
+    static auto zstd_deflate_into(Ref<Span<const u8>> data, Ref<Span<u8>> out, Ref<ZstdDictionary> dictionary)
+        -> Result<usize>;
+  };
+
+  class DataOps::Fnv1aHasher
+  {
+public:
+    auto reset() -> void;
+    auto update(Ref<Span<const u8>> data) -> void;
+    IA_NODISCARD auto digest() const -> u32;
+
+private:
+    Mut<u32> m_hash{0x811c9dc5};
+  };
+
+  class DataOps::XxhashHasher
+  {
+public:
+    explicit XxhashHasher(const u32 seed = 0);
+
+    auto reset(const u32 seed = 0) -> void;
+    auto update(Ref<Span<const u8>> data) -> void;
+    IA_NODISCARD auto digest() const -> u32;
+
+private:
+    Mut<u32> m_seed{};
+    Mut<u64> m_total_length{};
+    Mut<Array<u32, 4>> m_lanes{};
+    Mut<Array<u8, 16>> m_buffer{};
+    Mut<usize> m_buffered{};
+  };
+
+  class DataOps::Xxhash64Hasher
+  {
+public:
+    explicit Xxhash64Hasher(const u64 seed = 0);
+
+    auto reset(const u64 seed = 0) -> void;
+    auto update(Ref<Span<const u8>> data) -> void;
+    IA_NODISCARD auto digest() const -> u64;
+
+private:
+    Mut<u64> m_seed{};
+    Mut<u64> m_total_length{};
+    Mut<Array<u64, 4>> m_lanes{};
+    Mut<Array<u8, 32>> m_buffer{};
+    Mut<usize> m_buffered{};
+  };
+
+  // Produces both the 64-bit and 128-bit XXH3 digests of the same stream
+  class DataOps::Xxh3Hasher
+  {
+public:
+    explicit Xxh3Hasher(const u64 seed = 0);
+
+    auto reset(const u64 seed = 0) -> void;
+    auto update(Ref<Span<const u8>> data) -> void;
+    IA_NODISCARD auto digest() const -> u64;
+    IA_NODISCARD auto digest_128() const -> Hash128;
+
+private:
+    static constexpr const usize BUFFER_SIZE = 256;
+
+    auto digest_long(MutRef<Array<u64, 8>> acc) const -> void;
+
+    alignas(64) Mut<Array<u64, 8>> m_acc{};
+    alignas(64) Mut<Array<u8, 192>> m_secret{};
+    alignas(64) Mut<Array<u8, BUFFER_SIZE>> m_buffer{};
+    Mut<usize> m_buffered{};
+    Mut<usize> m_stripes_in_block{};
+    Mut<u64> m_total_length{};
+    Mut<u64> m_seed{};
+  };
+
+  class DataOps::Crc32Hasher
+  {
+public:
+    auto reset() -> void;
+    auto update(Ref<Span<const u8>> data) -> void;
+    IA_NODISCARD auto digest() const -> u32;
+
+private:
+    Mut<u32> m_crc{0};
+  };
+
+  // A dictionary digested once for both directions. It is read-only after creation and may be
+  // shared by any number of threads.
+  class DataOps::ZstdDictionary
+  {
+public:
+    static auto create(Ref<Span<const u8>> dictionary, const i32 level = 3) -> Result<ZstdDictionary>;
+
+    ZstdDictionary(ForwardRef<ZstdDictionary> other);
+    auto operator=(ForwardRef<ZstdDictionary> other) -> MutRef<ZstdDictionary>;
+
+    ZstdDictionary(Ref<ZstdDictionary>) = delete;
+    auto operator=(Ref<ZstdDictionary>) -> MutRef<ZstdDictionary> = delete;
+
+    ~ZstdDictionary();
+
+    IA_NODISCARD auto id() const -> u32;
+    IA_NODISCARD auto level() const -> i32;
+
+private:
+    friend class DataOps;
+
+    struct Impl;
+
+    explicit ZstdDictionary(Mut<Box<Impl>> impl);
+
+    Mut<Box<Impl>> m_impl;
+  };
+
+  // Random access into a zstd seekable archive. Only frames overlapping a requested range are
+  // decompressed. The archive is borrowed, not copied, so it must outlive the reader; a
+  // FileOps::map_file mapping works well.
+  class DataOps::ZstdSeekableReader
+  {
+public:
+    struct Frame
+    {
+      Mut<u64> compressed_offset{};
+      Mut<u64> decompressed_offset{};
+      Mut<u32> compressed_size{};
+      Mut<u32> decompressed_size{};
+      Mut<Option<u32>> checksum{}; // Low 32 bits of the frame's XXH64
+    };
+
+    static auto create(Ref<Span<const u8>> archive) -> Result<ZstdSeekableReader>;
+
+    IA_NODISCARD auto decompressed_size() const -> u64;
+    IA_NODISCARD auto frames() const -> Span<const Frame>;
+
+    // Fills `out` with the decompressed bytes starting at `offset`. With `workers` > 1 the frames
+    // are decoded in parallel on the AsyncOps workers.
+    auto read(const u64 offset, Ref<Span<u8>> out, const u32 workers = 1) const -> Result<void>;
+
+    auto read_all(const u32 workers = 1) const -> Result<Vec<u8>>;
+
+private:
+    Mut<Span<const u8>> m_archive{};
+    Mut<Vec<Frame>> m_frames;
+    Mut<u64> m_decompressed_size{};
+  };
+
+  // Chunked compression into a caller supplied sink. Compressed bytes are appended to the sink
+  // as the codec produces them, so memory use stays bounded by the codec window and a fixed
+  // staging buffer. The codec context is kept across reset(), making the object reusable.
+  class DataOps::StreamCompressor
+  {
+public:
+    // `type` must be Gzip, Zlib or Zstd (LZ4 has one-shot functions only). `options.workers` applies to zstd only.
+    static auto create(const CompressionType type, Ref<CompressionOptions> options = {}) -> Result<StreamCompressor>;
+
+    StreamCompressor(ForwardRef<StreamCompressor> other);
+    auto operator=(ForwardRef<StreamCompressor> other) -> MutRef<StreamCompressor>;
+
+    StreamCompressor(Ref<StreamCompressor>) = delete;
+    auto operator=(Ref<StreamCompressor>) -> MutRef<StreamCompressor> = delete;
+
+    ~StreamCompressor();
+
+    auto write(Ref<Span<const u8>> data, MutRef<StreamWriter> sink) -> Result<void>;
+
+    // Emits everything written so far in a form the receiver can decode without waiting for more
+    auto flush(MutRef<StreamWriter> sink) -> Result<void>;
+
+    // Ends the stream (trailer, checksum). Call reset() before writing the next stream.
+    auto finish(MutRef<StreamWriter> sink) -> Result<void>;
+
+    auto reset() -> Result<void>;
+
+    IA_NODISCARD auto type() const -> CompressionType;
+
+private:
+    struct Impl;
+
+    explicit StreamCompressor(Mut<Box<Impl>> impl);
+
+    Mut<Box<Impl>> m_impl;
+  };
+
+  // Chunked decompression into a caller supplied sink. Concatenated gzip members and zstd
+  // frames are decoded back to back.
+  class DataOps::StreamDecompressor
+  {
+public:
+    // `type` must be Gzip, Zlib or Zstd
+    static auto create(const CompressionType type) -> Result<StreamDecompressor>;
+
+    StreamDecompressor(ForwardRef<StreamDecompressor> other);
+    auto operator=(ForwardRef<StreamDecompressor> other) -> MutRef<StreamDecompressor>;
+
+    StreamDecompressor(Ref<StreamDecompressor>) = delete;
+    auto operator=(Ref<StreamDecompressor>) -> MutRef<StreamDecompressor> = delete;
+
+    ~StreamDecompressor();
+
+    auto write(Ref<Span<const u8>> data, MutRef<StreamWriter> sink) -> Result<void>;
+
+    // Fails if the input ended in the middle of a stream
+    auto finish() -> Result<void>;
+
+    auto reset() -> Result<void>;
+
+    IA_NODISCARD auto type() const -> CompressionType;
+
+private:
+    struct Impl;
+
+    explicit StreamDecompressor(Mut<Box<Impl>> impl);
+
+    Mut<Box<Impl>> m_impl;
   };
 } // namespace IACore
\ No newline at end of file
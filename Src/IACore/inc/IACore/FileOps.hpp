@@ -18,7 +18,7 @@
 #include <IACore/PCH.hpp>
 #include <IACore/StreamReader.hpp>
 #include <IACore/StreamWriter.hpp>
-#include <tuple>
+#include <functional>
 
 #if IA_PLATFORM_WINDOWS
 using NativeFileHandle = HANDLE;
@@ -35,6 +35,12 @@ namespace IACore
   {
 public:
     class MemoryMappedRegion;
+    class AsyncIo;
+    class AtomicWriteBatch;
+
+    // Buffer address, file offset and transfer size alignment that covers direct I/O on common
+    // devices and filesystems
+    static constexpr const usize DIRECT_IO_ALIGNMENT = 4096;
 
     enum class FileAccess : u8
     {
@@ -52,8 +58,11 @@ public:
       TruncateExisting // Opens existing and clears it
     };
 
+    // `direct_io` bypasses the page cache (O_DIRECT, FILE_FLAG_NO_BUFFERING, F_NOCACHE). Transfers on
+    // such handles must then be aligned to DIRECT_IO_ALIGNMENT.
     static auto native_open_file(Ref<Path> path, const FileAccess access, const FileMode mode,
-                                 const u32 permissions = 0644) -> Result<NativeFileHandle>;
+                                 const u32 permissions = 0644, const bool direct_io = false)
+        -> Result<NativeFileHandle>;
 
     static auto native_close_file(const NativeFileHandle handle) -> void;
 
@@ -78,13 +87,108 @@ public:
 
     static auto read_binary_file(Ref<Path> path) -> Result<Vec<u8>>;
 
+    // Reads many whole files with their reads batched through AsyncIo. Results are in `paths` order.
+    static auto read_binary_files(const Span<const Path> paths) -> Vec<Result<Vec<u8>>>;
+
     static auto write_text_file(Ref<Path> path, Ref<String> contents, const bool overwrite = false) -> Result<usize>;
 
     static auto write_binary_file(Ref<Path> path, const Span<const u8> contents, const bool overwrite = false)
         -> Result<usize>;
 
+    // Gathers `buffers` into as few write calls as possible (writev), at the handle's current position.
+    // Returns the bytes written.
+    static auto write_vectored(const NativeFileHandle handle, const Span<const Span<const u8>> buffers)
+        -> Result<usize>;
+    static auto write_vectored(Ref<Path> path, const Span<const Span<const u8>> buffers, const bool overwrite = false)
+        -> Result<usize>;
+
+    // Replaces `path` so that, even across a crash or power loss, it holds either the old or the new
+    // contents: writes a temp file beside it, flushes it to disk, renames it over `path` and syncs the
+    // directory. Use AtomicWriteBatch to replace many files for fewer flush round trips.
+    static auto write_file_atomic(Ref<Path> path, const Span<const u8> contents) -> Result<void>;
+
+    // Copies without passing the data through user space where the platform allows: reflink, then
+    // copy_file_range, then sendfile on Linux, clonefile/copyfile on Apple, CopyFile on Windows.
+    // Returns the bytes copied.
+    static auto copy_file(Ref<Path> from, Ref<Path> to, const bool overwrite = false) -> Result<usize>;
+
 private:
-    static Mut<HashMap<const u8 *, std::tuple<void *, void *, void *>>> s_mapped_files;
+    // What unmap_file needs to release a mapping from map_file or map_shared_memory
+    struct MappedFile
+    {
+      Mut<NativeFileHandle> file_handle{INVALID_FILE_HANDLE};
+      Mut<void *> address{};
+      Mut<usize> size{};
+#if IA_PLATFORM_WINDOWS
+      Mut<HANDLE> mapping_handle{};
+#endif
+    };
+
+    // Sharded by address, so threads mapping and unmapping different files rarely share a lock
+    class MappedFileRegistry
+    {
+  public:
+      auto insert(const u8 *address, Ref<MappedFile> file) -> void;
+      auto take(const u8 *address) -> Option<MappedFile>;
+
+  private:
+      static constexpr const usize SHARD_COUNT = 16;
+
+      struct alignas(64) Shard
+      {
+        Mut<std::mutex> mutex;
+        Mut<HashMap<const u8 *, MappedFile>> files;
+      };
+
+      auto shard_for(const u8 *address) -> MutRef<Shard>;
+
+      Mut<Array<Shard, SHARD_COUNT>> m_shards;
+    };
+
+    static Mut<MappedFileRegistry> s_mapped_files;
+  };
+
+  // Stages atomic replacements of many files and commits them together. Every file's data is written
+  // (and on Linux handed to writeback right away) before the first flush, so the device works through
+  // all of them in parallel, and each directory is synced once instead of once per file. Each file is
+  // replaced atomically; the batch as a whole is not.
+  class FileOps::AtomicWriteBatch
+  {
+public:
+    AtomicWriteBatch() = default;
+
+    // Deletes the temp files of anything not committed
+    ~AtomicWriteBatch();
+
+    AtomicWriteBatch(ForwardRef<AtomicWriteBatch> other) = default;
+    auto operator=(ForwardRef<AtomicWriteBatch> other) -> MutRef<AtomicWriteBatch>;
+
+    AtomicWriteBatch(Ref<AtomicWriteBatch>) = delete;
+    auto operator=(Ref<AtomicWriteBatch>) -> MutRef<AtomicWriteBatch> = delete;
+
+    // Writes `contents` to a temp file beside `path`. `path` is untouched until commit().
+    auto add(Ref<Path> path, const Span<const u8> contents) -> Result<void>;
+
+    // Flushes all staged files, renames them into place and syncs their directories. On failure the
+    // files not yet renamed stay staged.
+    auto commit() -> Result<void>;
+
+    auto discard() -> void;
+
+    IA_NODISCARD auto size() const -> usize
+    {
+      return m_entries.size();
+    }
+
+private:
+    struct Entry
+    {
+      Mut<Path> target;
+      Mut<Path> temp;
+      Mut<NativeFileHandle> handle{INVALID_FILE_HANDLE}; // Open until flushed
+    };
+
+    Mut<Vec<Entry>> m_entries;
   };
 
   class FileOps::MemoryMappedRegion
@@ -99,7 +203,13 @@ public:
     MemoryMappedRegion(ForwardRef<MemoryMappedRegion> other) noexcept;
     auto operator=(ForwardRef<MemoryMappedRegion> other) noexcept -> MemoryMappedRegion &;
 
-    auto map(const NativeFileHandle handle, const u64 offset, const usize size) -> Result<void>;
+    // `offset` must be a multiple of offset_alignment(). Writable mappings extend the file to cover
+    // the region; `read_only` ones need only read access and fail past the end of the file.
+    auto map(const NativeFileHandle handle, const u64 offset, const usize size, const bool read_only = false)
+        -> Result<void>;
+
+    // Page size on POSIX, allocation granularity on Windows
+    IA_NODISCARD static auto offset_alignment() -> usize;
 
     auto unmap() -> void;
     auto flush() -> void;
@@ -128,4 +238,80 @@ private:
 #endif
   };
 
+  // Batched asynchronous reads and writes at explicit offsets. On Linux this drives an io_uring
+  // instance through raw syscalls; elsewhere, or where io_uring is unavailable (old kernels,
+  // seccomp filters), requests run as blocking positional I/O on the AsyncOps blocking pool.
+  //
+  // read()/write() only queue a request, submit() hands the queue over in one go, and wait()
+  // runs the callbacks of finished requests on the calling thread. Callbacks may queue further
+  // requests. Buffers must stay valid until their request's callback has run. An instance is
+  // meant to be driven from one thread.
+  class FileOps::AsyncIo
+  {
+public:
+    enum class Backend : u8
+    {
+      IoUring,
+      ThreadPool
+    };
+
+    // Bytes transferred; reads stop short at end of file
+    using CompletionCallback = std::function<void(Result<usize> result)>;
+
+    struct Config
+    {
+      Mut<u32> queue_depth{256};         // Requests in flight at once (either backend), more wait in the queue
+      Mut<bool> force_thread_pool{false};
+    };
+
+    // Single requests are capped so the size fits io_uring's 32-bit length
+    static constexpr const usize MAX_REQUEST_SIZE = 1u << 30;
+
+    static auto create() -> Result<AsyncIo>;
+    static auto create(Ref<Config> config) -> Result<AsyncIo>;
+
+    AsyncIo(ForwardRef<AsyncIo> other);
+    auto operator=(ForwardRef<AsyncIo> other) -> MutRef<AsyncIo>;
+
+    // Waits for requests still in flight, dropping their callbacks
+    ~AsyncIo();
+
+    AsyncIo(Ref<AsyncIo>) = delete;
+    auto operator=(Ref<AsyncIo>) -> MutRef<AsyncIo> = delete;
+
+    auto read(const NativeFileHandle handle, const u64 offset, const Span<u8> buffer,
+              Mut<CompletionCallback> on_complete) -> Result<void>;
+    auto write(const NativeFileHandle handle, const u64 offset, const Span<const u8> data,
+               Mut<CompletionCallback> on_complete) -> Result<void>;
+
+    // Pins `buffers` once (IORING_REGISTER_BUFFERS) so the *_fixed requests skip the per-request
+    // page mapping. Replaces any previous registration; nothing may be queued or in flight.
+    auto register_buffers(const Span<const Span<u8>> buffers) -> Result<void>;
+
+    // `buffer` must lie inside registered buffer `buffer_index`
+    auto read_fixed(const NativeFileHandle handle, const u64 offset, const u32 buffer_index, const Span<u8> buffer,
+                    Mut<CompletionCallback> on_complete) -> Result<void>;
+    auto write_fixed(const NativeFileHandle handle, const u64 offset, const u32 buffer_index,
+                     const Span<const u8> data, Mut<CompletionCallback> on_complete) -> Result<void>;
+
+    // Returns the number of requests handed over
+    auto submit() -> Result<u32>;
+
+    // Submits, then blocks until at least `min_completions` callbacks have run (fewer if nothing
+    // else is outstanding). Returns the number run.
+    auto wait(const u32 min_completions = 1) -> Result<u32>;
+
+    // Waits until nothing is queued or in flight, including requests queued by callbacks
+    auto drain() -> Result<void>;
+
+    IA_NODISCARD auto outstanding() const -> usize;
+    IA_NODISCARD auto backend() const -> Backend;
+
+private:
+    struct Impl;
+    explicit AsyncIo(Mut<Box<Impl>> impl);
+
+    Mut<Box<Impl>> m_impl;
+  };
+
 } // namespace IACore
\ No newline at end of file
@@ -16,6 +16,7 @@
 #pragma once
 
 #include <IACore/ADT/RingBuffer.hpp>
+#include <IACore/DataOps.hpp>
 #include <IACore/ProcessOps.hpp>
 #include <IACore/SocketOps.hpp>
 
@@ -23,6 +24,10 @@ namespace IACore
 {
   using IpcPacketHeader = RingBufferView::PacketHeader;
 
+  // Once a compression dictionary is set on both ends, packet ids with this bit set carry a zstd
+  // payload packed with that dictionary. Without a dictionary, ids are delivered untouched.
+  static constexpr const u16 IPC_COMPRESSED_PACKET_FLAG = 0x8000;
+
   struct alignas(64) IpcSharedMemoryLayout
   {
     // =========================================================
@@ -84,6 +89,10 @@ public:
     auto send_signal(const u8 signal) -> void;
     auto send_packet(const u16 packet_id, const Span<const u8> payload) -> Result<void>;
 
+    // The manager must use the same dictionary. Compressed packets are inflated before on_packet.
+    auto set_compression_dictionary(ForwardRef<DataOps::ZstdDictionary> dictionary) -> void;
+    auto send_compressed_packet(const u16 packet_id, const Span<const u8> payload) -> Result<void>;
+
 protected:
     virtual auto on_signal(const u8 signal) -> void = 0;
     virtual auto on_packet(const u16 packet_id, const Span<const u8> payload) -> void = 0;
@@ -96,6 +105,8 @@ private:
 
     Mut<RingBufferView> m_moni; // Manager Out, Node In
     Mut<RingBufferView> m_mino; // Manager In, Node Out
+
+    Mut<Option<DataOps::ZstdDictionary>> m_compression_dictionary;
   };
 
   class IpcManager
@@ -140,6 +151,11 @@ public:
     auto send_signal(const NativeProcessID node, const u8 signal) -> void;
     auto send_packet(const NativeProcessID node, const u16 packet_id, const Span<const u8> payload) -> Result<void>;
 
+    // Shared by all nodes, each of which must use the same dictionary
+    auto set_compression_dictionary(ForwardRef<DataOps::ZstdDictionary> dictionary) -> void;
+    auto send_compressed_packet(const NativeProcessID node, const u16 packet_id, const Span<const u8> payload)
+        -> Result<void>;
+
 protected:
     virtual auto on_signal(const NativeProcessID node, const u8 signal) -> void = 0;
     virtual auto on_packet(const NativeProcessID node, const u16 packet_id, const Span<const u8> payload) -> void = 0;
@@ -149,6 +165,7 @@ private:
     Mut<Vec<Box<NodeSession>>> m_active_sessions;
     Mut<Vec<Box<NodeSession>>> m_pending_sessions;
     Mut<HashMap<NativeProcessID, NodeSession *>> m_active_session_map;
+    Mut<Option<DataOps::ZstdDictionary>> m_compression_dictionary;
 
 protected:
     IpcManager();
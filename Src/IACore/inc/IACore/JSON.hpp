@@ -16,6 +16,8 @@
 #pragma once
 
 #include <IACore/PCH.hpp>
+#include <IACore/StreamReader.hpp>
+#include <IACore/StreamWriter.hpp>
 
 #include <glaze/glaze.hpp>
 #include <nlohmann/json.hpp>
@@ -53,6 +55,7 @@ private:
   {
 private:
     static constexpr const glz::opts GLAZE_OPTS = glz::opts{.error_on_unknown_keys = false};
+    static constexpr const glz::opts GLAZE_BEVE_OPTS = glz::opts{.format = glz::BEVE, .error_on_unknown_keys = false};
 
 public:
     static auto parse(Ref<String> json_str) -> Result<nlohmann::json>;
@@ -63,6 +66,17 @@ public:
     template<typename T> static auto parse_to_struct(Ref<String> json_str) -> Result<T>;
 
     template<typename T> static auto encode_struct(Ref<T> data) -> Result<String>;
+
+    // BEVE, glaze's binary format: the same reflection as the struct JSON calls, without number
+    // formatting, string escaping or text parsing. Each value is preceded by its varint byte length,
+    // so it can sit between other data in a stream. Encoding stages the value in a reused per-thread
+    // buffer and copies it into the writer once, as the length must be known before the payload and
+    // file or segmented writers can't offer a growable in-place region. Decoding reads in place
+    // from the reader's storage.
+    template<typename T> static auto encode_struct_binary(Ref<T> data, MutRef<StreamWriter> writer) -> Result<void>;
+
+    template<typename T> static auto parse_struct_binary(MutRef<StreamReader> reader) -> Result<T>;
+    template<typename T> static auto parse_struct_binary(MutRef<StreamReader> reader, MutRef<T> out) -> Result<void>;
   };
 
   inline auto Json::parse(Ref<String> json_str) -> Result<nlohmann::json>
@@ -121,4 +135,48 @@ public:
     }
     return result;
   }
+
+  template<typename T>
+  inline auto Json::encode_struct_binary(Ref<T> data, MutRef<StreamWriter> writer) -> Result<void>
+  {
+    thread_local Mut<String> buffer;
+    buffer.clear();
+
+    const glz::error_ctx err = glz::write<GLAZE_BEVE_OPTS>(data, buffer);
+    if (err)
+    {
+      return fail("BEVE Struct Encode Error");
+    }
+
+    // Room for the longest u64 varint and the payload, so both land in one growth (or one chunk)
+    AU_TRY_PURE(writer.reserve(10 + buffer.size()));
+    AU_TRY_PURE(writer.write_varint<u64>(buffer.size()));
+    return writer.write(buffer.data(), buffer.size());
+  }
+
+  template<typename T> inline auto Json::parse_struct_binary(MutRef<StreamReader> reader) -> Result<T>
+  {
+    Mut<T> result{};
+    AU_TRY_PURE(parse_struct_binary(reader, result));
+    return result;
+  }
+
+  template<typename T>
+  inline auto Json::parse_struct_binary(MutRef<StreamReader> reader, MutRef<T> out) -> Result<void>
+  {
+    const u64 size = AU_TRY(reader.read_varint<u64>());
+    if (size > reader.remaining())
+    {
+      return fail("BEVE Struct Parse Error: {} byte value but only {} bytes left", size, reader.remaining());
+    }
+
+    const StringView payload = AU_TRY(reader.read_string_view(static_cast<usize>(size)));
+
+    const glz::error_ctx err = glz::read<GLAZE_BEVE_OPTS>(out, payload);
+    if (err)
+    {
+      return fail("BEVE Struct Parse Error: {}", glz::format_error(err, payload));
+    }
+    return {};
+  }
 } // namespace IACore
\ No newline at end of file
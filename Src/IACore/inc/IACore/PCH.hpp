@@ -55,6 +55,7 @@
 #endif
 
 #include <atomic>
+#include <bit>
 #include <cmath>
 #include <condition_variable>
 #include <cstddef>
@@ -118,6 +119,44 @@ namespace IACore
     }
   };
 
+  // =============================================================================
+  // Byte Order
+  // =============================================================================
+  // Swaps between host order and `order`, so the same call both encodes and decodes
+  template<typename T> [[nodiscard]] constexpr auto convert_byte_order(const T value, const std::endian order) -> T
+  {
+    static_assert(std::is_integral_v<T> || std::is_floating_point_v<T>, "T must be an integer or floating point type");
+
+    if (order == std::endian::native || sizeof(T) == 1)
+    {
+      return value;
+    }
+
+    if constexpr (std::is_floating_point_v<T>)
+    {
+      using Bits = std::conditional_t<sizeof(T) == 4, u32, u64>;
+      return std::bit_cast<T>(std::byteswap(std::bit_cast<Bits>(value)));
+    }
+    else
+    {
+      return std::byteswap(value);
+    }
+  }
+
+  // In place; the loop compiles to vector byte shuffles
+  template<typename T> constexpr auto convert_byte_order(const Span<T> values, const std::endian order) -> void
+  {
+    if (order == std::endian::native || sizeof(T) == 1)
+    {
+      return;
+    }
+
+    for (MutRef<T> value : values)
+    {
+      value = convert_byte_order(value, order);
+    }
+  }
+
   // =============================================================================
   // Console Colors
   // =============================================================================
@@ -35,6 +35,7 @@ public:
     struct Capabilities
     {
       Mut<bool> hardware_crc32 = false;
+      Mut<bool> hardware_clmul = false; // PCLMULQDQ on x64, PMULL on ARM64
     };
 
     static auto check_cpu() -> bool;
@@ -29,9 +29,18 @@ public:
       NonOwning,
       OwningMmap,
       OwningVector,
+      WindowedFile,
+    };
+
+    struct FileConfig
+    {
+      // Bytes mapped at once, 0 maps the whole file. Otherwise the mapping slides to wherever reads
+      // go, keeping address space and resident memory bounded for files of any size.
+      Mut<usize> window_size{0};
     };
 
     static auto create_from_file(Ref<Path> path) -> Result<StreamReader>;
+    static auto create_from_file(Ref<Path> path, Ref<FileConfig> config) -> Result<StreamReader>;
 
     explicit StreamReader(ForwardRef<Vec<u8>> data);
     explicit StreamReader(const Span<const u8> data);
@@ -49,6 +58,44 @@ public:
     [[nodiscard("Check for EOF")]]
     auto read() -> Result<T>;
 
+    // Unsigned LEB128
+    template<typename T>
+    [[nodiscard("Check for EOF")]]
+    auto read_varint() -> Result<T>;
+
+    // Zigzag-mapped LEB128 (as protobuf sint), so small negative values stay short too
+    template<typename T>
+    [[nodiscard("Check for EOF")]]
+    auto read_zigzag() -> Result<T>;
+
+    template<typename T>
+    [[nodiscard("Check for EOF")]]
+    auto read_le() -> Result<T>;
+
+    template<typename T>
+    [[nodiscard("Check for EOF")]]
+    auto read_be() -> Result<T>;
+
+    // One bounds check and copy for the whole array. Integer and floating point elements are then
+    // byte-swapped in place if `order` isn't native.
+    template<typename T> auto read_array(const Span<T> out, const std::endian order = std::endian::native)
+        -> Result<void>;
+
+    template<typename T>
+    [[nodiscard("Check for EOF")]]
+    auto read_array(const usize count, const std::endian order = std::endian::native) -> Result<Vec<T>>;
+
+    // Views into the reader's storage instead of copies, valid while the reader lives. For windowed
+    // files they are only valid until the window next moves; larger views enlarge the window for a while.
+    [[nodiscard("Check for EOF")]]
+    auto peek_span(const usize size) -> Result<Span<const u8>>;
+
+    [[nodiscard("Check for EOF")]]
+    auto read_span(const usize size) -> Result<Span<const u8>>;
+
+    [[nodiscard("Check for EOF")]]
+    auto read_string_view(const usize size) -> Result<StringView>;
+
     auto skip(const usize amount) -> void
     {
       m_cursor = std::min(m_cursor + amount, m_data_size);
@@ -80,21 +127,43 @@ public:
     }
 
 private:
-    Mut<const u8 *> m_data = nullptr;
+    struct FileWindow;
+
+    // Whether `size` bytes at the cursor are inside the current window
+    [[nodiscard]] auto in_window(const usize size) const -> bool
+    {
+      const usize window_cursor = m_cursor - m_window_offset; // Wraps when seeked before the window
+      return window_cursor <= m_window_size && size <= m_window_size - window_cursor;
+    }
+
+    // Slides the window of windowed files across the read, fails with EOF otherwise
+    auto read_outside_window(Mut<void *> buffer, const usize size) -> Result<void>;
+
+    // Maps the window containing `pos`, enlarged if needed to reach `min_size` bytes past it
+    auto slide_window(const usize pos, const usize min_size = 0) -> Result<void>;
+
+    // Moves the window of windowed files so `size` bytes at the cursor are in it, fails with EOF otherwise
+    auto map_for_view(const usize size) -> Result<void>;
+
+private:
+    Mut<const u8 *> m_data = nullptr; // Points at stream position m_window_offset
     Mut<usize> m_cursor = 0;
     Mut<usize> m_data_size = 0;
+    Mut<usize> m_window_offset = 0;
+    Mut<usize> m_window_size = 0; // m_data_size unless windowed
+    Mut<Box<FileWindow>> m_file_window;
     Mut<Vec<u8>> m_owning_vector;
     Mut<StorageType> m_storage_type = StorageType::NonOwning;
   };
 
   inline auto StreamReader::read(Mut<void *> buffer, const usize size) -> Result<void>
   {
-    if (m_cursor + size > m_data_size) [[unlikely]]
+    if (!in_window(size)) [[unlikely]]
     {
-      return fail("Unexpected EOF while reading");
+      return read_outside_window(buffer, size);
     }
 
-    std::memcpy(buffer, &m_data[m_cursor], size);
+    std::memcpy(buffer, &m_data[m_cursor - m_window_offset], size);
     m_cursor += size;
 
     return {};
@@ -108,16 +177,121 @@ private:
 
     constexpr const usize SIZE = sizeof(T);
 
-    if (m_cursor + SIZE > m_data_size) [[unlikely]]
+    Mut<T> value;
+    if (!in_window(SIZE)) [[unlikely]]
     {
-      return fail("Unexpected EOF while reading");
+      AU_TRY_PURE(read_outside_window(&value, SIZE));
+      return value;
     }
 
-    Mut<T> value;
-    std::memcpy(&value, &m_data[m_cursor], SIZE);
+    std::memcpy(&value, &m_data[m_cursor - m_window_offset], SIZE);
     m_cursor += SIZE;
 
     return value;
   }
 
+  template<typename T>
+  [[nodiscard("Check for EOF")]]
+  inline auto StreamReader::read_varint() -> Result<T>
+  {
+    static_assert(std::is_unsigned_v<T>, "Varints decode to unsigned integers, use read_zigzag for signed ones");
+
+    constexpr const usize MAX_BYTES = (sizeof(T) * 8 + 6) / 7;
+    constexpr const usize LAST_BYTE_BITS = sizeof(T) * 8 - 7 * (MAX_BYTES - 1);
+
+    Mut<T> value = 0;
+    for (Mut<usize> i = 0; i < MAX_BYTES; ++i)
+    {
+      const u8 byte = AU_TRY(read<u8>());
+      if (i == MAX_BYTES - 1 && (byte >> LAST_BYTE_BITS) != 0) [[unlikely]]
+      {
+        return fail("Varint overflows a {}-bit integer", sizeof(T) * 8);
+      }
+
+      value |= static_cast<T>(static_cast<T>(byte & 0x7F) << (7 * i));
+      if (!(byte & 0x80))
+      {
+        return value;
+      }
+    }
+
+    return fail("Varint overflows a {}-bit integer", sizeof(T) * 8);
+  }
+
+  template<typename T>
+  [[nodiscard("Check for EOF")]]
+  inline auto StreamReader::read_zigzag() -> Result<T>
+  {
+    static_assert(std::is_signed_v<T> && std::is_integral_v<T>, "Zigzag decodes to signed integers");
+
+    using Unsigned = std::make_unsigned_t<T>;
+    const Unsigned encoded = AU_TRY(read_varint<Unsigned>());
+    return static_cast<T>((encoded >> 1) ^ (~(encoded & 1) + 1));
+  }
+
+  template<typename T>
+  [[nodiscard("Check for EOF")]]
+  inline auto StreamReader::read_le() -> Result<T>
+  {
+    const T value = AU_TRY(read<T>());
+    return convert_byte_order(value, std::endian::little);
+  }
+
+  template<typename T>
+  [[nodiscard("Check for EOF")]]
+  inline auto StreamReader::read_be() -> Result<T>
+  {
+    const T value = AU_TRY(read<T>());
+    return convert_byte_order(value, std::endian::big);
+  }
+
+  template<typename T> inline auto StreamReader::read_array(const Span<T> out, const std::endian order) -> Result<void>
+  {
+    static_assert(std::is_trivially_copyable_v<T>, "T must be trivially copyable to read via memcpy");
+
+    AU_TRY_PURE(read(out.data(), out.size_bytes()));
+    if constexpr (std::is_integral_v<T> || std::is_floating_point_v<T>)
+    {
+      convert_byte_order(out, order);
+    }
+    return {};
+  }
+
+  template<typename T>
+  [[nodiscard("Check for EOF")]]
+  inline auto StreamReader::read_array(const usize count, const std::endian order) -> Result<Vec<T>>
+  {
+    if (count > remaining() / sizeof(T)) [[unlikely]]
+    {
+      return fail("Unexpected EOF while reading");
+    }
+
+    Mut<Vec<T>> values(count);
+    AU_TRY_PURE(read_array(Span<T>(values), order));
+    return values;
+  }
+
+  inline auto StreamReader::peek_span(const usize size) -> Result<Span<const u8>>
+  {
+    if (!in_window(size)) [[unlikely]]
+    {
+      AU_TRY_PURE(map_for_view(size));
+    }
+
+    return Span<const u8>(m_data + (m_cursor - m_window_offset), size);
+  }
+
+  inline auto StreamReader::read_span(const usize size) -> Result<Span<const u8>>
+  {
+    const Span<const u8> span = AU_TRY(peek_span(size));
+    m_cursor += size;
+    return span;
+  }
+
+  inline auto StreamReader::read_string_view(const usize size) -> Result<StringView>
+  {
+    const Span<const u8> span = AU_TRY(read_span(size));
+    return StringView(reinterpret_cast<const char *>(span.data()), span.size());
+  }
+
 } // namespace IACore
\ No newline at end of file
@@ -16,6 +16,9 @@
 #pragma once
 
 #include <IACore/PCH.hpp>
+#include <algorithm>
+#include <cstring>
+#include <memory_resource>
 
 namespace IACore
 {
@@ -28,11 +31,40 @@ public:
       NonOwning,
       OwningFile,
       OwningVector,
+      OwningSegments,
     };
 
+    struct BufferConfig
+    {
+      Mut<usize> initial_capacity{256};
+
+      // Continues in a new chunk when one fills instead of reallocating and copying what was
+      // written. The output is then read through segments(), data() and cursor() only cover the
+      // last chunk.
+      Mut<bool> segmented{false};
+      Mut<usize> max_chunk_size{1024 * 1024}; // Chunks double up to this, larger writes get their own
+
+      // Memory for the buffer or chunks, e.g. a std::pmr::monotonic_buffer_resource over a caller-owned
+      // block. Null uses malloc/realloc, which can grow large buffers in place.
+      Mut<std::pmr::memory_resource *> arena{nullptr};
+    };
+
+    struct FileConfig
+    {
+      Mut<usize> buffer_size{1024 * 1024};
+
+      // Hands each full buffer to the AsyncOps blocking pool and keeps filling a second one
+      // while it is written out, at the cost of twice the memory
+      Mut<bool> double_buffered{false};
+    };
+
+    // Streams to `path` through a fixed-size buffer that is written out whenever it fills, so memory
+    // use doesn't grow with the file. Writes larger than the buffer go to the file directly.
     static auto create_from_file(Ref<Path> path) -> Result<StreamWriter>;
+    static auto create_from_file(Ref<Path> path, Ref<FileConfig> config) -> Result<StreamWriter>;
 
     StreamWriter();
+    explicit StreamWriter(Ref<BufferConfig> config);
     explicit StreamWriter(const Span<u8> data);
 
     StreamWriter(ForwardRef<StreamWriter> other);
@@ -48,28 +80,84 @@ public:
 
     template<typename T> auto write(Ref<T> value) -> Result<void>;
 
+    // Unsigned LEB128
+    template<typename T> auto write_varint(const T value) -> Result<void>;
+
+    // Zigzag-mapped LEB128 (as protobuf sint), so small negative values stay short too
+    template<typename T> auto write_zigzag(const T value) -> Result<void>;
+
+    template<typename T> auto write_le(const T value) -> Result<void>;
+    template<typename T> auto write_be(const T value) -> Result<void>;
+
+    // Integer and floating point elements are byte-swapped if `order` isn't native
+    template<typename T>
+    auto write_array(const Span<const T> values, const std::endian order = std::endian::native) -> Result<void>;
+
+    // Makes room for `size` more bytes up front, so the writes that follow don't grow the buffer
+    // piecemeal. Growth never zero-fills.
+    auto reserve(const usize size) -> Result<void>;
+
     [[nodiscard]] auto data() const -> const u8 *
     {
       return m_buffer;
     }
 
+    // Everything written so far (still buffered, for file writers) as one span per chunk
+    [[nodiscard]] auto segments() const -> Vec<Span<const u8>>;
+
+    // Bytes in the buffer that `data()` points to. For file writers and segmented buffers that is
+    // only the part not yet drained or the last chunk, see total_written().
     [[nodiscard]] auto cursor() const -> usize
     {
       return m_cursor;
     }
 
+    // Total bytes written, including those already drained to the file or in earlier chunks
+    [[nodiscard]] auto total_written() const -> usize
+    {
+      return m_flushed + m_cursor;
+    }
+
+    // For file writers: hands everything buffered to the OS and waits for it. The file stays open.
     auto flush() -> Result<void>;
 
 private:
+    struct FileSink;
+
+    struct Chunk
+    {
+      Mut<u8 *> data{};
+      Mut<usize> size{};
+      Mut<usize> capacity{};
+    };
+
     Mut<u8 *> m_buffer = nullptr;
     Mut<usize> m_cursor = 0;
     Mut<usize> m_capacity = 0;
-    Mut<Path> m_file_path;
-    Mut<Vec<u8>> m_owning_vector;
+    Mut<usize> m_flushed = 0; // Bytes before m_buffer, in the file or in earlier chunks
+    Mut<Box<FileSink>> m_file_sink;
+    Mut<Vec<Chunk>> m_full_chunks; // Segmented: chunks before m_buffer
+    Mut<usize> m_max_chunk_size = 0;
+    Mut<std::pmr::memory_resource *> m_arena = nullptr;
     Mut<StorageType> m_storage_type = StorageType::OwningVector;
 
 private:
     auto flush_to_disk() -> Result<void>;
+
+    // Makes room in a file writer's buffer
+    auto drain_buffer() -> Result<void>;
+
+    // Reallocates an owned contiguous buffer to `capacity`, keeping the bytes written
+    auto grow_buffer(const usize capacity) -> Result<void>;
+
+    // Retires the current chunk as full and starts one with room for at least `size` bytes
+    auto start_chunk(const usize size) -> Result<void>;
+
+    auto allocate_block(const usize size) -> u8 *;
+    auto free_block(Mut<u8 *> block, const usize size) -> void;
+
+    // Frees owned buffers and chunks
+    auto release() -> void;
   };
 
   template<typename T> inline auto StreamWriter::write(Ref<T> value) -> Result<void>
@@ -77,4 +165,66 @@ private:
     return write(&value, sizeof(T));
   }
 
+  template<typename T> inline auto StreamWriter::write_varint(const T value) -> Result<void>
+  {
+    static_assert(std::is_unsigned_v<T>, "Varints encode unsigned integers, use write_zigzag for signed ones");
+
+    Mut<Array<u8, (sizeof(T) * 8 + 6) / 7>> bytes;
+    Mut<usize> count = 0;
+    Mut<T> remaining = value;
+    while (remaining >= 0x80)
+    {
+      bytes[count++] = static_cast<u8>(remaining | 0x80);
+      remaining >>= 7;
+    }
+    bytes[count++] = static_cast<u8>(remaining);
+
+    return write(bytes.data(), count);
+  }
+
+  template<typename T> inline auto StreamWriter::write_zigzag(const T value) -> Result<void>
+  {
+    static_assert(std::is_signed_v<T> && std::is_integral_v<T>, "Zigzag encodes signed integers");
+
+    using Unsigned = std::make_unsigned_t<T>;
+    return write_varint<Unsigned>(static_cast<Unsigned>(static_cast<Unsigned>(value) << 1) ^
+                                  static_cast<Unsigned>(value >> (sizeof(T) * 8 - 1)));
+  }
+
+  template<typename T> inline auto StreamWriter::write_le(const T value) -> Result<void>
+  {
+    return write(convert_byte_order(value, std::endian::little));
+  }
+
+  template<typename T> inline auto StreamWriter::write_be(const T value) -> Result<void>
+  {
+    return write(convert_byte_order(value, std::endian::big));
+  }
+
+  template<typename T>
+  inline auto StreamWriter::write_array(const Span<const T> values, const std::endian order) -> Result<void>
+  {
+    static_assert(std::is_trivially_copyable_v<T>, "T must be trivially copyable to write via memcpy");
+
+    if constexpr (std::is_integral_v<T> || std::is_floating_point_v<T>)
+    {
+      if (order != std::endian::native && sizeof(T) > 1)
+      {
+        // Swapped a chunk at a time, the caller's array stays untouched
+        constexpr const usize CHUNK = 4096 / sizeof(T);
+        Mut<Array<T, CHUNK>> swapped;
+        for (Mut<usize> i = 0; i < values.size(); i += CHUNK)
+        {
+          const usize count = std::min(CHUNK, values.size() - i);
+          std::memcpy(swapped.data(), values.data() + i, count * sizeof(T));
+          convert_byte_order(Span<T>(swapped.data(), count), order);
+          AU_TRY_PURE(write(swapped.data(), count * sizeof(T)));
+        }
+        return {};
+      }
+    }
+
+    return write(values.data(), values.size_bytes());
+  }
+
 } // namespace IACore
\ No newline at end of file
@@ -22,7 +22,24 @@ namespace IACore
   class StringOps
   {
 public:
+    enum class Base64Alphabet
+    {
+      Standard, // RFC 4648 section 4, '+' and '/'
+      UrlSafe   // RFC 4648 section 5, '-' and '_'
+    };
+
+public:
+    // Standard alphabet with padding. Decoding is lenient: it stops at the first character outside
+    // the alphabet, padding included.
     static auto encode_base64(const Span<const u8> data) -> String;
     static auto decode_base64(Ref<String> data) -> Vec<u8>;
+
+    // `pad` appends '=' up to a multiple of four characters (URL-safe encodings often omit it)
+    static auto encode_base64(const Span<const u8> data, const Base64Alphabet alphabet, const bool pad = true)
+        -> String;
+
+    // Strict decoding: fails on characters outside `alphabet`, misplaced padding, impossible lengths
+    // and non-zero bits after the last byte. Padding is optional.
+    static auto decode_base64(Ref<String> data, const Base64Alphabet alphabet) -> Result<Vec<u8>>;
   };
 } // namespace IACore
\ No newline at end of file
@@ -36,10 +36,25 @@ public:
 
     static auto sleep(const u64 milliseconds) -> void;
 
+    enum class HexCase
+    {
+      Upper,
+      Lower
+    };
+
     static auto binary_to_hex_string(const Span<const u8> data) -> String;
+    static auto binary_to_hex_string(const Span<const u8> data, const HexCase letter_case) -> String;
 
+    // Writes 2 * data.size() characters to `out` and returns that count, failing if `out` is too small
+    static auto binary_to_hex(const Span<const u8> data, const Span<char> out,
+                              const HexCase letter_case = HexCase::Upper) -> Result<usize>;
+
+    // Accepts either case
     static auto hex_string_to_binary(const StringView hex) -> Result<Vec<u8>>;
 
+    // Writes hex.size() / 2 bytes to `out` and returns that count
+    static auto hex_to_binary(const StringView hex, const Span<u8> out) -> Result<usize>;
+
     template<typename Range> inline static auto sort(ForwardRef<Range> range) -> void
     {
       std::ranges::sort(std::forward<Range>(range));
@@ -136,6 +136,50 @@ auto test_run_task_fire_and_forget() -> bool
   return true;
 }
 
+auto test_run_task_bounded_pool() -> bool
+{
+  AsyncOps::configure_blocking_pool({.core_threads = 0, .max_threads = 3, .idle_timeout_ms = 50});
+
+  std::atomic<i32> running{0};
+  std::atomic<i32> peak{0};
+  std::atomic<i32> done{0};
+
+  constexpr i32 TASK_COUNT = 32;
+  for (i32 i = 0; i < TASK_COUNT; ++i)
+  {
+    AsyncOps::run_task([&]() {
+      const i32 now_running = ++running;
+      i32 expected = peak.load();
+      while (expected < now_running && !peak.compare_exchange_weak(expected, now_running))
+      {
+      }
+      std::this_thread::sleep_for(std::chrono::milliseconds(2));
+      running--;
+      done++;
+    });
+  }
+
+  IAT_CHECK(AsyncOps::get_blocking_pool_thread_count() <= 3u);
+
+  for (int i = 0; i < 500 && done.load() < TASK_COUNT; ++i)
+  {
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+  }
+  IAT_CHECK_EQ(done.load(), TASK_COUNT);
+  IAT_CHECK(peak.load() <= 3);
+
+  // Elastic threads retire once idle past the timeout
+  for (int i = 0; i < 100 && AsyncOps::get_blocking_pool_thread_count() > 0; ++i)
+  {
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  }
+  IAT_CHECK_EQ(AsyncOps::get_blocking_pool_thread_count(), 0u);
+
+  AsyncOps::configure_blocking_pool({});
+
+  return true;
+}
+
 auto test_cancellation_safety() -> bool
 {
   SchedulerGuard guard(2);
@@ -155,13 +199,184 @@ auto test_cancellation_safety() -> bool
   return true;
 }
 
+auto test_worker_stats() -> bool
+{
+  SchedulerGuard guard(2);
+
+  AsyncOps::reset_worker_stats();
+
+  AsyncOps::Schedule schedule;
+  const i32 total_tasks = 64;
+
+  for (i32 i = 0; i < total_tasks; ++i)
+  {
+    AsyncOps::schedule_task([](AsyncOps::WorkerId) { std::this_thread::sleep_for(std::chrono::microseconds(50)); },
+                            0, &schedule);
+  }
+
+  AsyncOps::wait_for_schedule_completion(&schedule);
+
+  u64 tasks_run = 0;
+  u64 busy_ns = 0;
+  u64 high_water = 0;
+  for (AsyncOps::WorkerId id = 0; id <= AsyncOps::get_worker_count(); ++id)
+  {
+    const AsyncOps::WorkerStats stats = AsyncOps::get_worker_stats(id);
+    tasks_run += stats.tasks_run;
+    busy_ns += stats.busy_ns;
+    high_water = std::max(high_water, stats.queue_depth_high_water);
+  }
+
+  IAT_CHECK_EQ(tasks_run, static_cast<u64>(total_tasks));
+  IAT_CHECK(busy_ns > 0);
+  IAT_CHECK(high_water > 0);
+
+  const AsyncOps::WorkerStats invalid = AsyncOps::get_worker_stats(1000);
+  IAT_CHECK_EQ(invalid.tasks_run, static_cast<u64>(0));
+
+  return true;
+}
+
+auto test_trace_export() -> bool
+{
+  SchedulerGuard guard(2);
+
+  AsyncOps::enable_tracing(8);
+
+  AsyncOps::Schedule schedule;
+  for (i32 i = 0; i < 32; ++i)
+  {
+    AsyncOps::schedule_task([](AsyncOps::WorkerId) {}, 42, &schedule);
+  }
+  AsyncOps::wait_for_schedule_completion(&schedule);
+
+  AsyncOps::disable_tracing();
+
+  const Vec<AsyncOps::TraceEvent> events = AsyncOps::get_trace_events();
+  IAT_CHECK(!events.empty());
+  IAT_CHECK(events.size() <= static_cast<usize>(8 * (AsyncOps::get_worker_count() + 1)));
+
+  for (const AsyncOps::TraceEvent &event : events)
+  {
+    IAT_CHECK_EQ(event.tag, static_cast<AsyncOps::TaskTag>(42));
+    IAT_CHECK(event.end_ns >= event.begin_ns);
+  }
+
+  const String json = AsyncOps::export_chrome_trace();
+  IAT_CHECK(json.starts_with("{\"displayTimeUnit\""));
+  IAT_CHECK(json.find("\"traceEvents\"") != String::npos);
+  IAT_CHECK(json.find("\"tag\":42") != String::npos);
+
+  // Worker names are escaped so the export stays valid JSON
+  auto named_res = AsyncOps::Scheduler::create({.worker_count = 1, .name = "Odd \"Name\\"});
+  IAT_CHECK(named_res.has_value());
+  IAT_CHECK((*named_res)->export_chrome_trace().find(R"("name":"Odd \"Name\\ 1")") != String::npos);
+
+  return true;
+}
+
+auto test_schedule_after() -> bool
+{
+  SchedulerGuard guard(2);
+
+  AsyncOps::Schedule schedule;
+  std::atomic<i32> counter{0};
+
+  const auto start = std::chrono::steady_clock::now();
+  AsyncOps::schedule_after(20, [&](AsyncOps::WorkerId) { counter++; }, 1, &schedule);
+  AsyncOps::schedule_after(5, [&](AsyncOps::WorkerId) { counter++; }, 1, &schedule);
+
+  const auto cancelled = AsyncOps::schedule_after(10, [&](AsyncOps::WorkerId) { counter += 100; }, 1, &schedule);
+  IAT_CHECK(AsyncOps::cancel_timer(cancelled));
+  IAT_CHECK_NOT(AsyncOps::cancel_timer(cancelled));
+
+  AsyncOps::wait_for_schedule_completion(&schedule);
+  const auto elapsed = std::chrono::steady_clock::now() - start;
+
+  IAT_CHECK_EQ(counter.load(), 2);
+  IAT_CHECK(elapsed >= std::chrono::milliseconds(20));
+
+  return true;
+}
+
+auto test_schedule_every() -> bool
+{
+  // Declared before the guard so firings still queued at teardown don't touch a dead counter
+  std::atomic<i32> counter{0};
+  SchedulerGuard guard(2);
+
+  const auto handle = AsyncOps::schedule_every(2, [&](AsyncOps::WorkerId) { counter++; }, 2);
+  IAT_CHECK(handle != AsyncOps::INVALID_TIMER_HANDLE);
+
+  for (i32 i = 0; i < 500 && counter.load() < 3; ++i)
+  {
+    std::this_thread::sleep_for(std::chrono::milliseconds(2));
+  }
+  IAT_CHECK(counter.load() >= 3);
+
+  IAT_CHECK(AsyncOps::cancel_timer(handle));
+  IAT_CHECK_NOT(AsyncOps::cancel_timer(handle));
+
+  return true;
+}
+
+auto test_independent_schedulers() -> bool
+{
+  auto low_latency_res = AsyncOps::Scheduler::create({.worker_count = 1, .name = "LowLatency"});
+  IAT_CHECK(low_latency_res.has_value());
+  auto throughput_res = AsyncOps::Scheduler::create({.worker_count = 3, .name = "Batch"});
+  IAT_CHECK(throughput_res.has_value());
+
+  auto &low_latency = **low_latency_res;
+  auto &throughput = **throughput_res;
+
+  IAT_CHECK_EQ(low_latency.get_worker_count(), static_cast<u16>(1));
+  IAT_CHECK_EQ(throughput.get_worker_count(), static_cast<u16>(3));
+  IAT_CHECK_NOT(low_latency.start({}).has_value());
+
+  AsyncOps::Schedule low_schedule;
+  AsyncOps::Schedule batch_schedule;
+  std::atomic<i32> low_count{0};
+  std::atomic<i32> batch_count{0};
+
+  for (i32 i = 0; i < 10; ++i)
+  {
+    low_latency.schedule_task([&](AsyncOps::WorkerId) { low_count++; }, 0, &low_schedule);
+    throughput.schedule_task([&](AsyncOps::WorkerId) { batch_count++; }, 0, &batch_schedule);
+  }
+
+  low_latency.wait_for_schedule_completion(&low_schedule);
+  throughput.wait_for_schedule_completion(&batch_schedule);
+
+  IAT_CHECK_EQ(low_count.load(), 10);
+  IAT_CHECK_EQ(batch_count.load(), 10);
+
+  u64 low_total = 0;
+  for (AsyncOps::WorkerId i = 0; i <= low_latency.get_worker_count(); ++i)
+  {
+    low_total += low_latency.get_worker_stats(i).tasks_run;
+  }
+  IAT_CHECK_EQ(low_total, static_cast<u64>(10));
+
+  const auto bad_pin = AsyncOps::Scheduler::create({.worker_count = 1, .pinned_cpus = {100000}});
+  IAT_CHECK_NOT(bad_pin.has_value());
+
+  return true;
+}
+
 IAT_BEGIN_TEST_LIST()
 IAT_ADD_TEST(test_initialization);
 IAT_ADD_TEST(test_basic_execution);
 IAT_ADD_TEST(test_concurrency);
 IAT_ADD_TEST(test_priorities);
 IAT_ADD_TEST(test_run_task_fire_and_forget);
+IAT_ADD_TEST(test_run_task_bounded_pool);
 IAT_ADD_TEST(test_cancellation_safety);
+IAT_ADD_TEST(test_worker_stats);
+IAT_ADD_TEST(test_trace_export);
+IAT_ADD_TEST(test_schedule_after);
+IAT_ADD_TEST(test_schedule_every);
+IAT_ADD_TEST(test_independent_schedulers);
 IAT_END_TEST_LIST()
 
 IAT_END_BLOCK()
@@ -13,8 +13,10 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <IACore/AsyncOps.hpp>
 #include <IACore/DataOps.hpp>
 #include <IACore/IATest.hpp>
+#include <IACore/StreamWriter.hpp>
 
 using namespace IACore;
 
@@ -58,6 +60,52 @@ auto test_crc32() -> bool
   return true;
 }
 
+auto test_crc32_large_and_incremental() -> bool
+{
+  // Long enough to go through both three-way block sizes plus an unaligned tail
+  Vec<u8> data(3 * 8192 * 2 + 3 * 256 + 1000 + 5);
+  u32 state = 0x12345678;
+  for (u8 &b : data)
+  {
+    state = state * 1664525 + 1013904223;
+    b = static_cast<u8>(state >> 24);
+  }
+
+  u32 reference = 0xFFFFFFFF;
+  for (const u8 b : data)
+  {
+    reference ^= b;
+    for (i32 k = 0; k < 8; ++k)
+    {
+      reference = (reference >> 1) ^ ((reference & 1) ? 0x82F63B78 : 0);
+    }
+  }
+  reference = ~reference;
+
+  const Span<const u8> all(data);
+  IAT_CHECK_EQ(DataOps::crc32(all), reference);
+
+  u32 running = 0;
+  usize offset = 0;
+  usize chunk = 1;
+  while (offset < data.size())
+  {
+    const usize size = std::min(chunk, data.size() - offset);
+    running = DataOps::crc32_update(running, all.subspan(offset, size));
+    offset += size;
+    chunk = chunk * 3 + 7;
+  }
+  IAT_CHECK_EQ(running, reference);
+
+  const usize split = 20001;
+  const u32 crc_a = DataOps::crc32(all.first(split));
+  const u32 crc_b = DataOps::crc32(all.subspan(split));
+  IAT_CHECK_EQ(DataOps::crc32_combine(crc_a, crc_b, data.size() - split), reference);
+  IAT_CHECK_EQ(DataOps::crc32_combine(reference, DataOps::crc32({}), 0), reference);
+
+  return true;
+}
+
 auto test_hash_xxhash() -> bool
 {
   {
@@ -82,6 +130,87 @@ auto test_hash_xxhash() -> bool
   return true;
 }
 
+auto test_hash_xxhash64_and_xxh3() -> bool
+{
+  const String s = "Hello, World!";
+  IAT_CHECK_EQ(DataOps::hash_xxhash64(s), 0xC49AACF8080FE47FULL);
+  IAT_CHECK_EQ(DataOps::hash_xxhash64(s, 42), 0xC2E0FE28B2512846ULL);
+  IAT_CHECK_EQ(DataOps::hash_xxh3(s), 0x60415D5F616602AAULL);
+  IAT_CHECK_EQ(DataOps::hash_xxh3(s, 42), 0x9125EABA28E37E5BULL);
+  IAT_CHECK_EQ(DataOps::hash_xxh3(Span<const u8>{}), 0x2D06800538D394C2ULL);
+
+  const DataOps::Hash128 h128 = DataOps::hash_xxh3_128(s);
+  IAT_CHECK_EQ(h128.low, 0x77DB03842CD75395ULL);
+  IAT_CHECK_EQ(h128.high, 0x531DF2844447DD50ULL);
+
+  Vec<u8> data(4096);
+  for (usize i = 0; i < data.size(); ++i)
+  {
+    data[i] = static_cast<u8>(i * 31 + 7);
+  }
+  const Span<const u8> all(data);
+
+  // Lengths covering the short, mid-size and vectorized long paths
+  IAT_CHECK_EQ(DataOps::hash_xxh3(all.first(17), 7), 0x6DC13BD6E6AB1788ULL);
+  IAT_CHECK_EQ(DataOps::hash_xxh3(all.first(200), 7), 0x30EF6FF6A38035EDULL);
+  IAT_CHECK_EQ(DataOps::hash_xxh3(all, 7), 0x9375CEBE9A7C3674ULL);
+  IAT_CHECK_EQ(DataOps::hash_xxhash64(all.first(100), 7), 0xA110DBEF405C5A24ULL);
+  IAT_CHECK_EQ(DataOps::hash_xxhash64(all, 7), 0xB2DF96FAA2AF6A8FULL);
+  IAT_CHECK(DataOps::hash_xxh3_128(all.first(200), 7) ==
+            (DataOps::Hash128{0x868FEC00FCE0D3DCULL, 0x34E8D7494F7A08E9ULL}));
+  IAT_CHECK(DataOps::hash_xxh3_128(all, 7) == (DataOps::Hash128{0x9375CEBE9A7C3674ULL, 0xEB4E42879A9D70A3ULL}));
+
+  return true;
+}
+
+auto test_streaming_hashers() -> bool
+{
+  Vec<u8> data(5000);
+  for (usize i = 0; i < data.size(); ++i)
+  {
+    data[i] = static_cast<u8>((i * 131) ^ (i >> 3));
+  }
+  const Span<const u8> all(data);
+
+  DataOps::Fnv1aHasher fnv;
+  DataOps::XxhashHasher xxh32(5);
+  DataOps::Xxhash64Hasher xxh64(5);
+  DataOps::Xxh3Hasher xxh3(5);
+  DataOps::Crc32Hasher crc;
+
+  // Uneven chunk sizes so buffered tails straddle stripe and block boundaries
+  const usize chunk_sizes[] = {1, 3, 15, 16, 33, 64, 100, 255, 256, 257, 1024};
+  Mut<usize> offset = 0;
+  for (Mut<usize> i = 0; offset < data.size(); ++i)
+  {
+    const usize size = std::min(chunk_sizes[i % std::size(chunk_sizes)], data.size() - offset);
+    const Span<const u8> chunk = all.subspan(offset, size);
+    fnv.update(chunk);
+    xxh32.update(chunk);
+    xxh64.update(chunk);
+    xxh3.update(chunk);
+    crc.update(chunk);
+    offset += size;
+  }
+
+  IAT_CHECK_EQ(fnv.digest(), DataOps::hash_fnv1a(all));
+  IAT_CHECK_EQ(xxh32.digest(), DataOps::hash_xxhash(all, 5));
+  IAT_CHECK_EQ(xxh64.digest(), DataOps::hash_xxhash64(all, 5));
+  IAT_CHECK_EQ(xxh3.digest(), DataOps::hash_xxh3(all, 5));
+  IAT_CHECK(xxh3.digest_128() == DataOps::hash_xxh3_128(all, 5));
+  IAT_CHECK_EQ(crc.digest(), DataOps::crc32(all));
+
+  // Reset hashers start over, short inputs take the one-shot short paths
+  xxh3.reset();
+  xxh3.update(all.first(100));
+  IAT_CHECK_EQ(xxh3.digest(), DataOps::hash_xxh3(all.first(100)));
+
+  crc.reset();
+  IAT_CHECK_EQ(crc.digest(), DataOps::crc32({}));
+
+  return true;
+}
+
 auto test_hash_fnv1a() -> bool
 {
   {
@@ -98,10 +227,353 @@ auto test_hash_fnv1a() -> bool
   return true;
 }
 
+auto test_stream_compression_roundtrip() -> bool
+{
+  Vec<u8> data(300000);
+  for (usize i = 0; i < data.size(); ++i)
+  {
+    data[i] = static_cast<u8>((i % 251) ^ (i / 4096));
+  }
+  const Span<const u8> all(data);
+
+  const DataOps::CompressionType types[] = {DataOps::CompressionType::Gzip, DataOps::CompressionType::Zlib,
+                                            DataOps::CompressionType::Zstd};
+  for (const DataOps::CompressionType type : types)
+  {
+    auto compressor_res = DataOps::StreamCompressor::create(type);
+    IAT_CHECK(compressor_res.has_value());
+    auto compressor = std::move(*compressor_res);
+
+    auto decompressor_res = DataOps::StreamDecompressor::create(type);
+    IAT_CHECK(decompressor_res.has_value());
+    auto decompressor = std::move(*decompressor_res);
+
+    // Run twice to cover context reuse after reset()
+    for (Mut<i32> pass = 0; pass < 2; ++pass)
+    {
+      IAT_CHECK(compressor.reset().has_value());
+      IAT_CHECK(decompressor.reset().has_value());
+
+      StreamWriter compressed;
+      for (Mut<usize> offset = 0; offset < data.size(); offset += 7000)
+      {
+        IAT_CHECK(compressor.write(all.subspan(offset, std::min<usize>(7000, data.size() - offset)), compressed)
+                      .has_value());
+      }
+      IAT_CHECK(compressor.finish(compressed).has_value());
+
+      const Span<const u8> packed(compressed.data(), compressed.cursor());
+      IAT_CHECK(DataOps::detect_compression(packed) == type);
+
+      StreamWriter restored;
+      for (Mut<usize> offset = 0; offset < packed.size(); offset += 1000)
+      {
+        IAT_CHECK(
+            decompressor.write(packed.subspan(offset, std::min<usize>(1000, packed.size() - offset)), restored)
+                .has_value());
+      }
+      IAT_CHECK(decompressor.finish().has_value());
+      IAT_CHECK_EQ(restored.cursor(), data.size());
+      IAT_CHECK(std::memcmp(restored.data(), data.data(), data.size()) == 0);
+    }
+  }
+
+  // Streamed output stays compatible with the one-shot inflaters
+  {
+    auto compressor = std::move(*DataOps::StreamCompressor::create(DataOps::CompressionType::Gzip));
+    StreamWriter compressed;
+    IAT_CHECK(compressor.write(all, compressed).has_value());
+    IAT_CHECK(compressor.finish(compressed).has_value());
+
+    const auto inflated = DataOps::gzip_inflate(Span<const u8>(compressed.data(), compressed.cursor()));
+    IAT_CHECK(inflated.has_value());
+    IAT_CHECK(*inflated == data);
+  }
+
+  // A truncated stream is reported by finish()
+  {
+    const auto packed = DataOps::zstd_deflate(all);
+    IAT_CHECK(packed.has_value());
+
+    auto decompressor = std::move(*DataOps::StreamDecompressor::create(DataOps::CompressionType::Zstd));
+    StreamWriter restored;
+    IAT_CHECK(decompressor.write(Span<const u8>(*packed).first(packed->size() / 2), restored).has_value());
+    IAT_CHECK_NOT(decompressor.finish().has_value());
+  }
+
+  IAT_CHECK_NOT(DataOps::StreamCompressor::create(DataOps::CompressionType::None).has_value());
+
+  return true;
+}
+
+auto test_compress_into_buffer() -> bool
+{
+  Vec<u8> message(1024);
+  for (usize i = 0; i < message.size(); ++i)
+  {
+    message[i] = static_cast<u8>("IACore small payload "[i % 21]);
+  }
+  const Span<const u8> input(message);
+
+  Vec<u8> packed(DataOps::zstd_deflate_bound(message.size()));
+  Vec<u8> restored(message.size());
+
+  // Repeated calls reuse the thread's context
+  for (Mut<i32> i = 0; i < 3; ++i)
+  {
+    const auto zstd_size = DataOps::zstd_deflate_into(input, packed);
+    IAT_CHECK(zstd_size.has_value());
+    const auto zstd_restored = DataOps::zstd_inflate_into(Span<const u8>(packed.data(), *zstd_size), restored);
+    IAT_CHECK(zstd_restored.has_value());
+    IAT_CHECK_EQ(*zstd_restored, message.size());
+    IAT_CHECK(restored == message);
+  }
+
+  packed.resize(DataOps::gzip_deflate_bound(message.size()));
+  const auto gzip_size = DataOps::gzip_deflate_into(input, packed);
+  IAT_CHECK(gzip_size.has_value());
+  IAT_CHECK(DataOps::detect_compression(Span<const u8>(packed.data(), *gzip_size)) ==
+            DataOps::CompressionType::Gzip);
+  std::fill(restored.begin(), restored.end(), u8{0});
+  const auto gzip_restored = DataOps::gzip_inflate_into(Span<const u8>(packed.data(), *gzip_size), restored);
+  IAT_CHECK(gzip_restored.has_value());
+  IAT_CHECK(restored == message);
+
+  packed.resize(DataOps::zlib_deflate_bound(message.size()));
+  const auto zlib_size = DataOps::zlib_deflate_into(input, packed);
+  IAT_CHECK(zlib_size.has_value());
+  const auto zlib_vec = DataOps::zlib_inflate(Span<const u8>(packed.data(), *zlib_size));
+  IAT_CHECK(zlib_vec.has_value());
+  IAT_CHECK(*zlib_vec == message);
+
+  // Too small output buffers fail instead of truncating
+  Vec<u8> tiny(16);
+  IAT_CHECK_NOT(DataOps::zlib_inflate_into(Span<const u8>(packed.data(), *zlib_size), tiny).has_value());
+  IAT_CHECK_NOT(DataOps::zstd_deflate_into(input, Span<u8>(tiny.data(), 4)).has_value());
+
+  return true;
+}
+
+auto test_zstd_dictionary() -> bool
+{
+  Vec<String> records;
+  for (Mut<i32> i = 0; i < 1000; ++i)
+  {
+    records.push_back(std::format(R"({{"id":{},"type":"position_update","entity":"player_{}","x":{}.5,"y":{}.25,)"
+                                  R"("flags":["visible","collidable"],"zone":"overworld"}})",
+                                  i, i % 37, i * 3, i * 7));
+  }
+
+  Vec<Span<const u8>> samples;
+  for (Ref<String> record : records)
+  {
+    samples.emplace_back(reinterpret_cast<const u8 *>(record.data()), record.size());
+  }
+
+  const auto trained = DataOps::zstd_train_dictionary(samples, 4096);
+  IAT_CHECK(trained.has_value());
+  IAT_CHECK(!trained->empty());
+
+  auto dictionary_res = DataOps::ZstdDictionary::create(*trained);
+  IAT_CHECK(dictionary_res.has_value());
+  const auto dictionary = std::move(*dictionary_res);
+  IAT_CHECK(dictionary.id() != 0);
+
+  const Span<const u8> record = samples[123];
+  const auto packed = DataOps::zstd_deflate(record, dictionary);
+  IAT_CHECK(packed.has_value());
+
+  const auto packed_plain = DataOps::zstd_deflate(record);
+  IAT_CHECK(packed_plain.has_value());
+  IAT_CHECK(packed->size() < packed_plain->size());
+
+  const auto restored = DataOps::zstd_inflate(*packed, dictionary);
+  IAT_CHECK(restored.has_value());
+  IAT_CHECK_EQ(String(restored->begin(), restored->end()), records[123]);
+
+  Vec<u8> out(record.size());
+  const auto restored_size = DataOps::zstd_inflate_into(*packed, out, dictionary);
+  IAT_CHECK(restored_size.has_value());
+  IAT_CHECK_EQ(*restored_size, record.size());
+
+  // Frames made with a dictionary can't be read without it
+  IAT_CHECK_NOT(DataOps::zstd_inflate(*packed).has_value());
+
+  return true;
+}
+
+auto test_parallel_compression() -> bool
+{
+  Vec<u8> data(5 * 1024 * 1024 + 12345);
+  Mut<u32> state = 0x12345678;
+  for (usize i = 0; i < data.size(); ++i)
+  {
+    // Compressible but not trivially so
+    state = state * 1664525 + 1013904223;
+    data[i] = static_cast<u8>((state >> 28) + 'a');
+  }
+  const Span<const u8> all(data);
+
+  IAT_CHECK(AsyncOps::initialize_scheduler(4).has_value());
+
+  const DataOps::CompressionOptions options{.level = 6, .workers = 4};
+
+  const auto gzip_parallel = DataOps::gzip_deflate(all, options);
+  AsyncOps::terminate_scheduler();
+  IAT_CHECK(gzip_parallel.has_value());
+  IAT_CHECK(DataOps::detect_compression(*gzip_parallel) == DataOps::CompressionType::Gzip);
+
+  const auto gzip_restored = DataOps::gzip_inflate(*gzip_parallel);
+  IAT_CHECK(gzip_restored.has_value());
+  IAT_CHECK(*gzip_restored == data);
+
+  // Block priming keeps the ratio close to a single stream
+  const auto gzip_single = DataOps::gzip_deflate(all, DataOps::CompressionOptions{.level = 6});
+  IAT_CHECK(gzip_single.has_value());
+  IAT_CHECK(gzip_parallel->size() < gzip_single->size() + gzip_single->size() / 50);
+
+  const auto zstd_parallel = DataOps::zstd_deflate(all, DataOps::CompressionOptions{.level = 5, .workers = 4});
+  IAT_CHECK(zstd_parallel.has_value());
+  const auto zstd_restored = DataOps::zstd_inflate(*zstd_parallel);
+  IAT_CHECK(zstd_restored.has_value());
+  IAT_CHECK(*zstd_restored == data);
+
+  IAT_CHECK_NOT(DataOps::gzip_deflate(all, DataOps::CompressionOptions{.level = 42}).has_value());
+
+  return true;
+}
+
+auto test_zstd_seekable() -> bool
+{
+  Vec<u8> data(300000);
+  for (usize i = 0; i < data.size(); ++i)
+  {
+    data[i] = static_cast<u8>((i * 7) ^ (i >> 9));
+  }
+  const Span<const u8> all(data);
+
+  IAT_CHECK(AsyncOps::initialize_scheduler(2).has_value());
+  const auto archive = DataOps::zstd_seekable_deflate(all, DataOps::CompressionOptions{.workers = 3}, 64 * 1024);
+  IAT_CHECK(archive.has_value());
+
+  // Still a plain zstd stream, the seek table is a skippable frame
+  IAT_CHECK(DataOps::detect_compression(*archive) == DataOps::CompressionType::Zstd);
+  const auto plain = DataOps::zstd_inflate(*archive);
+  IAT_CHECK(plain.has_value());
+  IAT_CHECK(*plain == data);
+
+  const auto reader = DataOps::ZstdSeekableReader::create(*archive);
+  IAT_CHECK(reader.has_value());
+  IAT_CHECK_EQ(reader->decompressed_size(), static_cast<u64>(data.size()));
+  IAT_CHECK_EQ(reader->frames().size(), static_cast<usize>(5));
+
+  // A range straddling frame boundaries, decoded both serially and on the workers
+  Mut<Vec<u8>> range(150000);
+  IAT_CHECK(reader->read(60000, range).has_value());
+  IAT_CHECK(std::equal(range.begin(), range.end(), data.begin() + 60000));
+
+  std::ranges::fill(range, 0);
+  IAT_CHECK(reader->read(60000, range, 4).has_value());
+  IAT_CHECK(std::equal(range.begin(), range.end(), data.begin() + 60000));
+
+  const auto everything = reader->read_all(4);
+  AsyncOps::terminate_scheduler();
+  IAT_CHECK(everything.has_value());
+  IAT_CHECK(*everything == data);
+
+  Mut<Vec<u8>> tail(10);
+  IAT_CHECK_NOT(reader->read(data.size() - 5, tail).has_value());
+
+  // Corrupting a frame's payload is caught by the frame checksum or the decoder
+  Mut<Vec<u8>> corrupt = *archive;
+  corrupt[reader->frames()[1].compressed_offset + 20] ^= 0xFF;
+  const auto corrupt_reader = DataOps::ZstdSeekableReader::create(corrupt);
+  IAT_CHECK(corrupt_reader.has_value());
+  IAT_CHECK_NOT(corrupt_reader->read_all().has_value());
+
+  IAT_CHECK_NOT(DataOps::ZstdSeekableReader::create(*DataOps::zstd_deflate(all)).has_value());
+
+  return true;
+}
+
+auto test_lz4_and_dispatch() -> bool
+{
+  Vec<u8> data(200000);
+  for (usize i = 0; i < data.size(); ++i)
+  {
+    data[i] = static_cast<u8>((i % 251) ^ (i >> 10));
+  }
+  const Span<const u8> all(data);
+
+  const auto lz4 = DataOps::lz4_deflate(all);
+  IAT_CHECK(lz4.has_value());
+  IAT_CHECK(lz4->size() < data.size());
+  IAT_CHECK(DataOps::detect_compression(*lz4) == DataOps::CompressionType::Lz4);
+
+  const auto restored = DataOps::lz4_inflate(*lz4);
+  IAT_CHECK(restored.has_value());
+  IAT_CHECK(*restored == data);
+
+  // Concatenated frames decode as one stream
+  Mut<Vec<u8>> twice = *lz4;
+  twice.insert(twice.end(), lz4->begin(), lz4->end());
+  const auto doubled = DataOps::lz4_inflate(twice);
+  IAT_CHECK(doubled.has_value());
+  IAT_CHECK_EQ(doubled->size(), data.size() * 2);
+
+  Mut<Vec<u8>> compressed(DataOps::lz4_deflate_bound(data.size()));
+  const auto compressed_size = DataOps::lz4_deflate_into(all, compressed);
+  IAT_CHECK(compressed_size.has_value());
+  const Span<const u8> frame(compressed.data(), *compressed_size);
+
+  Mut<Vec<u8>> decoded(data.size());
+  const auto decoded_size = DataOps::lz4_inflate_into(frame, decoded);
+  IAT_CHECK(decoded_size.has_value());
+  IAT_CHECK_EQ(*decoded_size, data.size());
+  IAT_CHECK(decoded == data);
+
+  Mut<Vec<u8>> too_small(data.size() - 1);
+  IAT_CHECK_NOT(DataOps::lz4_inflate_into(frame, too_small).has_value());
+  IAT_CHECK_NOT(DataOps::lz4_inflate(frame.first(frame.size() - 8)).has_value());
+
+  const auto hc = DataOps::lz4_deflate(all, DataOps::CompressionOptions{.level = 9});
+  IAT_CHECK(hc.has_value());
+  IAT_CHECK(hc->size() <= lz4->size());
+
+  const DataOps::CompressionType types[] = {DataOps::CompressionType::Gzip, DataOps::CompressionType::Zlib,
+                                            DataOps::CompressionType::Zstd, DataOps::CompressionType::Lz4};
+  for (const auto type : types)
+  {
+    const auto packed = DataOps::compress(type, all);
+    IAT_CHECK(packed.has_value());
+    IAT_CHECK(DataOps::detect_compression(*packed) == type);
+
+    const auto unpacked = DataOps::decompress(*packed);
+    IAT_CHECK(unpacked.has_value());
+    IAT_CHECK(*unpacked == data);
+  }
+
+  const auto stored = DataOps::compress(DataOps::CompressionType::None, all);
+  IAT_CHECK(stored.has_value());
+  IAT_CHECK(*stored == data);
+  IAT_CHECK_NOT(DataOps::decompress(all).has_value());
+
+  return true;
+}
+
 IAT_BEGIN_TEST_LIST()
 IAT_ADD_TEST(test_crc32);
+IAT_ADD_TEST(test_crc32_large_and_incremental);
 IAT_ADD_TEST(test_hash_fnv1a);
 IAT_ADD_TEST(test_hash_xxhash);
+IAT_ADD_TEST(test_hash_xxhash64_and_xxh3);
+IAT_ADD_TEST(test_streaming_hashers);
+IAT_ADD_TEST(test_stream_compression_roundtrip);
+IAT_ADD_TEST(test_compress_into_buffer);
+IAT_ADD_TEST(test_zstd_dictionary);
+IAT_ADD_TEST(test_parallel_compression);
+IAT_ADD_TEST(test_zstd_seekable);
+IAT_ADD_TEST(test_lz4_and_dispatch);
 IAT_END_TEST_LIST()
 
 IAT_END_BLOCK()
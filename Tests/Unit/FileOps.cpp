@@ -151,12 +151,260 @@ auto test_stream_integration() -> bool
   return true;
 }
 
+auto test_async_io() -> bool
+{
+  const Path path = "iatest_fileops_async.bin";
+  cleanup_file(path);
+
+  Vec<u8> content(3 * 4096 + 123);
+  for (usize i = 0; i < content.size(); ++i)
+  {
+    content[i] = static_cast<u8>(i * 7);
+  }
+
+  for (const bool force_thread_pool : {false, true})
+  {
+    auto io_res = FileOps::AsyncIo::create({.queue_depth = 4, .force_thread_pool = force_thread_pool});
+    IAT_CHECK(io_res.has_value());
+    auto &io = *io_res;
+    if (force_thread_pool)
+    {
+      IAT_CHECK(io.backend() == FileOps::AsyncIo::Backend::ThreadPool);
+    }
+
+    auto handle_res = FileOps::native_open_file(path, FileOps::FileAccess::ReadWrite,
+                                                FileOps::FileMode::CreateAlways);
+    IAT_CHECK(handle_res.has_value());
+    const auto handle = *handle_res;
+
+    // More chunks than the queue depth, so some wait for ring space
+    usize written = 0;
+    for (usize offset = 0; offset < content.size(); offset += 1024)
+    {
+      const usize size = std::min<usize>(1024, content.size() - offset);
+      IAT_CHECK(io.write(handle, offset, Span<const u8>(content.data() + offset, size), [&](Result<usize> result) {
+                    written += result.value_or(0);
+                  }).has_value());
+    }
+    const auto submitted = io.submit();
+    IAT_CHECK(submitted.has_value());
+    IAT_CHECK_EQ(*submitted, 4u);
+    IAT_CHECK(io.drain().has_value());
+    IAT_CHECK_EQ(written, content.size());
+
+    Vec<u8> registered(content.size() + 100);
+    const Span<u8> buffers[] = {Span<u8>(registered)};
+    IAT_CHECK(io.register_buffers(buffers).has_value());
+
+    // Reads past the end stop short
+    usize read = 0;
+    IAT_CHECK(io.read_fixed(handle, 0, 0, Span<u8>(registered), [&](Result<usize> result) {
+                    read = result.value_or(0);
+                  }).has_value());
+    IAT_CHECK_EQ(io.outstanding(), 1u);
+    IAT_CHECK(io.drain().has_value());
+    IAT_CHECK_EQ(read, content.size());
+    IAT_CHECK(std::equal(content.begin(), content.end(), registered.begin()));
+
+    Vec<u8> outside(16);
+    IAT_CHECK_NOT(io.read_fixed(handle, 0, 0, Span<u8>(outside), nullptr).has_value());
+
+    FileOps::native_close_file(handle);
+  }
+
+  const Path paths[] = {path, "iatest_fileops_async_missing.bin"};
+  const auto files = FileOps::read_binary_files(paths);
+  IAT_CHECK_EQ(files.size(), 2u);
+  IAT_CHECK(files[0].has_value());
+  IAT_CHECK(*files[0] == content);
+  IAT_CHECK_NOT(files[1].has_value());
+
+  // Not every filesystem accepts O_DIRECT (tmpfs), so only check it reads correctly when it opens
+  auto direct_res = FileOps::native_open_file(path, FileOps::FileAccess::Read, FileOps::FileMode::OpenExisting,
+                                              0644, true);
+  if (direct_res.has_value())
+  {
+    auto io_res = FileOps::AsyncIo::create();
+    IAT_CHECK(io_res.has_value());
+
+    alignas(FileOps::DIRECT_IO_ALIGNMENT) static u8 aligned[4 * FileOps::DIRECT_IO_ALIGNMENT];
+    usize read = 0;
+    IAT_CHECK(io_res->read(*direct_res, 0, Span<u8>(aligned), [&](Result<usize> result) {
+                        read = result.value_or(0);
+                      }).has_value());
+    IAT_CHECK(io_res->drain().has_value());
+    IAT_CHECK_EQ(read, content.size());
+    IAT_CHECK(std::equal(content.begin(), content.end(), aligned));
+
+    FileOps::native_close_file(*direct_res);
+  }
+
+  cleanup_file(path);
+  return true;
+}
+
+auto test_vectored_and_copy() -> bool
+{
+  const Path path = "iatest_fileops_vectored.bin";
+  const Path copy_path = "iatest_fileops_copy.bin";
+  cleanup_file(path);
+  cleanup_file(copy_path);
+
+  const Vec<u8> header = {'I', 'A', 1};
+  const Vec<u8> body(100000, 0x5A);
+  const Vec<u8> footer = {0xFF, 0xEE};
+  const Span<const u8> buffers[] = {header, {}, body, footer};
+
+  const auto write_res = FileOps::write_vectored(path, buffers);
+  IAT_CHECK(write_res.has_value());
+  IAT_CHECK_EQ(*write_res, header.size() + body.size() + footer.size());
+  IAT_CHECK_NOT(FileOps::write_vectored(path, buffers).has_value());
+
+  Vec<u8> expected = header;
+  expected.insert(expected.end(), body.begin(), body.end());
+  expected.insert(expected.end(), footer.begin(), footer.end());
+
+  const auto read_res = FileOps::read_binary_file(path);
+  IAT_CHECK(read_res.has_value());
+  IAT_CHECK(*read_res == expected);
+
+  const auto copy_res = FileOps::copy_file(path, copy_path);
+  IAT_CHECK(copy_res.has_value());
+  IAT_CHECK_EQ(*copy_res, expected.size());
+
+  const auto copied = FileOps::read_binary_file(copy_path);
+  IAT_CHECK(copied.has_value());
+  IAT_CHECK(*copied == expected);
+
+  IAT_CHECK_NOT(FileOps::copy_file(path, copy_path).has_value());
+  IAT_CHECK(FileOps::copy_file(path, copy_path, true).has_value());
+  IAT_CHECK_NOT(FileOps::copy_file("iatest_fileops_missing.bin", copy_path, true).has_value());
+
+  // Copying a file onto itself must fail without truncating it
+  IAT_CHECK_NOT(FileOps::copy_file(path, path, true).has_value());
+  const auto self_copied = FileOps::read_binary_file(path);
+  IAT_CHECK(self_copied.has_value());
+  IAT_CHECK(*self_copied == expected);
+
+  cleanup_file(path);
+  cleanup_file(copy_path);
+  return true;
+}
+
+auto test_atomic_replace() -> bool
+{
+  const Path dir = "iatest_fileops_atomic";
+  std::error_code ec;
+  std::filesystem::remove_all(dir, ec);
+  std::filesystem::create_directory(dir, ec);
+
+  const Path path = dir / "config.bin";
+  const Vec<u8> old_contents = {1, 2, 3};
+  const Vec<u8> new_contents = {4, 5, 6, 7};
+
+  IAT_CHECK(FileOps::write_binary_file(path, old_contents, true).has_value());
+  IAT_CHECK(FileOps::write_file_atomic(path, new_contents).has_value());
+  IAT_CHECK(*FileOps::read_binary_file(path) == new_contents);
+
+#if IA_PLATFORM_UNIX
+  // Permissions survive the replacement even where the umask would strip them
+  const auto group_writable = std::filesystem::perms::owner_read | std::filesystem::perms::owner_write |
+                              std::filesystem::perms::group_read | std::filesystem::perms::group_write;
+  std::filesystem::permissions(path, group_writable, ec);
+  IAT_CHECK(FileOps::write_file_atomic(path, new_contents).has_value());
+  IAT_CHECK(std::filesystem::status(path, ec).permissions() == group_writable);
+#endif
+
+  {
+    FileOps::AtomicWriteBatch batch;
+    for (u8 i = 0; i < 5; ++i)
+    {
+      const Vec<u8> contents(100, i);
+      IAT_CHECK(batch.add(dir / ("file" + std::to_string(i)), contents).has_value());
+    }
+    IAT_CHECK_EQ(batch.size(), 5u);
+
+    // Nothing is visible before commit
+    IAT_CHECK_NOT(std::filesystem::exists(dir / "file0"));
+    IAT_CHECK(batch.commit().has_value());
+    IAT_CHECK_EQ(batch.size(), 0u);
+
+    for (u8 i = 0; i < 5; ++i)
+    {
+      const auto contents = FileOps::read_binary_file(dir / ("file" + std::to_string(i)));
+      IAT_CHECK(contents.has_value());
+      IAT_CHECK(*contents == Vec<u8>(100, i));
+    }
+  }
+
+  // A failed rename still leaves the entries moved before it in place
+  {
+    std::filesystem::create_directories(dir / "occupied" / "child", ec);
+
+    FileOps::AtomicWriteBatch batch;
+    IAT_CHECK(batch.add(dir / "occupied", old_contents).has_value());
+    IAT_CHECK(batch.add(path, old_contents).has_value());
+    IAT_CHECK_NOT(batch.commit().has_value());
+    IAT_CHECK(*FileOps::read_binary_file(path) == old_contents);
+
+    std::filesystem::remove_all(dir / "occupied", ec);
+    IAT_CHECK(FileOps::write_file_atomic(path, new_contents).has_value());
+  }
+
+  // Dropped batches leave targets and no temp files behind
+  {
+    FileOps::AtomicWriteBatch batch;
+    IAT_CHECK(batch.add(path, old_contents).has_value());
+  }
+  IAT_CHECK(*FileOps::read_binary_file(path) == new_contents);
+  IAT_CHECK_EQ(std::distance(std::filesystem::directory_iterator(dir), std::filesystem::directory_iterator()), 6);
+
+  std::filesystem::remove_all(dir, ec);
+  return true;
+}
+
+auto test_concurrent_mapping() -> bool
+{
+  const Path path = "iatest_fileops_concurrent_map.txt";
+  const String content = "SharedMapping";
+  (void) FileOps::write_text_file(path, content, true);
+
+  std::atomic<u32> failures{0};
+  {
+    Vec<std::jthread> threads;
+    for (u32 t = 0; t < 4; ++t)
+    {
+      threads.emplace_back([&]() {
+        for (u32 i = 0; i < 200; ++i)
+        {
+          usize size = 0;
+          const auto map_res = FileOps::map_file(path, size);
+          if (!map_res.has_value() || size != content.size() || std::memcmp(*map_res, content.data(), size) != 0)
+          {
+            failures.fetch_add(1);
+            continue;
+          }
+          FileOps::unmap_file(*map_res);
+        }
+      });
+    }
+  }
+  IAT_CHECK_EQ(failures.load(), 0u);
+
+  cleanup_file(path);
+  return true;
+}
+
 IAT_BEGIN_TEST_LIST()
 IAT_ADD_TEST(test_text_io);
 IAT_ADD_TEST(test_binary_io);
 IAT_ADD_TEST(test_file_mapping);
 IAT_ADD_TEST(test_shared_memory);
 IAT_ADD_TEST(test_stream_integration);
+IAT_ADD_TEST(test_async_io);
+IAT_ADD_TEST(test_vectored_and_copy);
+IAT_ADD_TEST(test_atomic_replace);
+IAT_ADD_TEST(test_concurrent_mapping);
 IAT_END_TEST_LIST()
 
 IAT_END_BLOCK()
@@ -122,6 +122,39 @@ auto test_struct_parse_error() -> bool
   return true;
 }
 
+auto test_struct_binary_round_trip() -> bool
+{
+  const UserProfile first{.username = "test_user", .id = 12345, .is_active = true, .roles = {"admin", "editor"}};
+  const UserProfile second{.username = "other", .id = 7, .is_active = false, .roles = {}};
+
+  StreamWriter writer;
+  IAT_CHECK(Json::encode_struct_binary(first, writer).has_value());
+  IAT_CHECK(writer.write<u32>(0xDEADBEEF).has_value());
+  IAT_CHECK(Json::encode_struct_binary(second, writer).has_value());
+
+  StreamReader reader(Span<const u8>(writer.data(), writer.cursor()));
+
+  auto decoded_first = Json::parse_struct_binary<UserProfile>(reader);
+  IAT_CHECK(decoded_first.has_value());
+  IAT_CHECK(*decoded_first == first);
+
+  // Values are framed, so surrounding stream data stays readable
+  auto marker = reader.read<u32>();
+  IAT_CHECK(marker.has_value());
+  IAT_CHECK_EQ(*marker, 0xDEADBEEFu);
+
+  UserProfile decoded_second{.username = "stale", .id = 1, .is_active = true, .roles = {"x"}};
+  IAT_CHECK(Json::parse_struct_binary(reader, decoded_second).has_value());
+  IAT_CHECK(decoded_second == second);
+  IAT_CHECK(reader.is_eof());
+
+  // Truncated payload
+  StreamReader truncated(Span<const u8>(writer.data(), 4));
+  IAT_CHECK_NOT(Json::parse_struct_binary<UserProfile>(truncated).has_value());
+
+  return true;
+}
+
 auto test_read_only() -> bool
 {
   const String json_text = R"({
@@ -160,6 +193,7 @@ IAT_ADD_TEST(test_dynamic_encode);
 IAT_ADD_TEST(test_parse_invalid);
 IAT_ADD_TEST(test_struct_round_trip);
 IAT_ADD_TEST(test_struct_parse_error);
+IAT_ADD_TEST(test_struct_binary_round_trip);
 IAT_ADD_TEST(test_read_only);
 IAT_END_TEST_LIST()
 
@@ -13,6 +13,7 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <IACore/FileOps.hpp>
 #include <IACore/IATest.hpp>
 #include <IACore/StreamReader.hpp>
 
@@ -129,6 +130,116 @@ auto test_boundary_checks() -> bool
   return true;
 }
 
+auto test_malformed_varints() -> bool
+{
+  // 2^32 doesn't fit in a u32, and an unterminated varint runs into EOF
+  const u8 overflow[] = {0x80, 0x80, 0x80, 0x80, 0x10};
+  StreamReader overflow_reader(overflow);
+  IAT_CHECK_NOT(overflow_reader.read_varint<u32>().has_value());
+
+  const u8 max[] = {0xFF, 0xFF, 0xFF, 0xFF, 0x0F};
+  StreamReader max_reader(max);
+  auto value = max_reader.read_varint<u32>();
+  IAT_CHECK(value.has_value());
+  IAT_CHECK_EQ(*value, 0xFFFFFFFFu);
+
+  const u8 truncated[] = {0x80, 0x80};
+  StreamReader truncated_reader(truncated);
+  IAT_CHECK_NOT(truncated_reader.read_varint<u64>().has_value());
+
+  return true;
+}
+
+auto test_spans() -> bool
+{
+  const u8 data[] = {'I', 'A', 0x05, 'h', 'e', 'l', 'l', 'o', 0xFF};
+  StreamReader reader(data);
+
+  auto magic = reader.peek_span(2);
+  IAT_CHECK(magic.has_value());
+  IAT_CHECK_EQ(magic->data(), &data[0]);
+  IAT_CHECK_EQ(reader.cursor(), static_cast<usize>(0));
+
+  auto header = reader.read_span(2);
+  IAT_CHECK(header.has_value());
+  IAT_CHECK_EQ(header->data(), &data[0]);
+
+  auto length = reader.read<u8>();
+  IAT_CHECK(length.has_value());
+
+  auto text = reader.read_string_view(*length);
+  IAT_CHECK(text.has_value());
+  IAT_CHECK(*text == "hello");
+  IAT_CHECK_EQ(reinterpret_cast<const u8 *>(text->data()), &data[3]);
+
+  IAT_CHECK_NOT(reader.read_span(2).has_value());
+  IAT_CHECK_EQ(reader.cursor(), static_cast<usize>(8));
+
+  auto empty = reader.read_span(0);
+  IAT_CHECK(empty.has_value());
+  IAT_CHECK(empty->empty());
+
+  return true;
+}
+
+auto test_windowed_file() -> bool
+{
+  const Path path = "iatest_stream_reader_windowed.bin";
+
+  // Odd size, so u32 reads from offset 1 straddle every window boundary
+  Vec<u8> content(3 * 65536 + 7);
+  for (usize i = 0; i < content.size(); ++i)
+  {
+    content[i] = static_cast<u8>(i ^ (i >> 8));
+  }
+  IAT_CHECK(FileOps::write_binary_file(path, content, true).has_value());
+
+  {
+    // Rounded up to the mapping alignment
+    auto res = StreamReader::create_from_file(path, {.window_size = 1});
+    IAT_CHECK(res.has_value());
+    StreamReader reader = std::move(*res);
+    IAT_CHECK_EQ(reader.size(), content.size());
+
+    reader.skip(1);
+    while (reader.remaining() >= sizeof(u32))
+    {
+      const usize pos = reader.cursor();
+      auto value = reader.read<u32>();
+      IAT_CHECK(value.has_value());
+
+      u32 expected;
+      std::memcpy(&expected, &content[pos], sizeof(expected));
+      IAT_CHECK_EQ(*value, expected);
+    }
+    IAT_CHECK_NOT(reader.read<u32>().has_value());
+
+    // Backwards seek and a read spanning several windows
+    Vec<u8> span(2 * 65536 + 100);
+    reader.seek(3);
+    IAT_CHECK(reader.read(span.data(), span.size()).has_value());
+    IAT_CHECK(std::equal(span.begin(), span.end(), content.begin() + 3));
+
+    // Views across window boundaries, and larger than the window, move or enlarge it
+    reader.seek(65536 - 2);
+    auto view = reader.read_span(4);
+    IAT_CHECK(view.has_value());
+    IAT_CHECK(std::equal(view->begin(), view->end(), content.begin() + 65536 - 2));
+
+    auto large_view = reader.peek_span(2 * 65536);
+    IAT_CHECK(large_view.has_value());
+    IAT_CHECK(std::equal(large_view->begin(), large_view->end(), content.begin() + 65536 + 2));
+
+    reader.seek(content.size() - 2);
+    IAT_CHECK_NOT(reader.read(span.data(), 3).has_value());
+    IAT_CHECK(reader.read(span.data(), 2).has_value());
+    IAT_CHECK(reader.is_eof());
+  }
+
+  std::filesystem::remove(path);
+  return true;
+}
+
 IAT_BEGIN_TEST_LIST()
 IAT_ADD_TEST(test_read_uint8);
 IAT_ADD_TEST(test_read_multi_byte);
@@ -136,6 +247,9 @@ IAT_ADD_TEST(test_read_float);
 IAT_ADD_TEST(test_read_buffer);
 IAT_ADD_TEST(test_navigation);
 IAT_ADD_TEST(test_boundary_checks);
+IAT_ADD_TEST(test_malformed_varints);
+IAT_ADD_TEST(test_spans);
+IAT_ADD_TEST(test_windowed_file);
 IAT_END_TEST_LIST()
 
 IAT_END_BLOCK()
@@ -15,6 +15,7 @@
 
 #include <IACore/FileOps.hpp>
 #include <IACore/IATest.hpp>
+#include <IACore/StreamReader.hpp>
 #include <IACore/StreamWriter.hpp>
 
 using namespace IACore;
@@ -93,6 +94,58 @@ auto test_file_writer() -> bool
   return true;
 }
 
+auto test_file_writer_streaming() -> bool
+{
+  const Path path = "test_stream_writer_streaming.bin";
+
+  for (const bool double_buffered : {false, true})
+  {
+    Vec<u8> expected;
+
+    {
+      auto res = StreamWriter::create_from_file(path, {.buffer_size = 64, .double_buffered = double_buffered});
+      IAT_CHECK(res.has_value());
+      StreamWriter writer = std::move(*res);
+
+      // Small writes that straddle buffer boundaries, fills and writes larger than the buffer
+      for (u32 i = 0; i < 500; ++i)
+      {
+        IAT_CHECK(writer.write(i).has_value());
+        expected.insert(expected.end(), reinterpret_cast<const u8 *>(&i), reinterpret_cast<const u8 *>(&i) + 4);
+
+        if (i % 100 == 0)
+        {
+          IAT_CHECK(writer.write(static_cast<u8>(i), 150).has_value());
+          expected.insert(expected.end(), 150, static_cast<u8>(i));
+
+          Vec<u8> large(200, static_cast<u8>(i + 1));
+          IAT_CHECK(writer.write(large.data(), large.size()).has_value());
+          expected.insert(expected.end(), large.begin(), large.end());
+        }
+      }
+      IAT_CHECK_EQ(writer.total_written(), expected.size());
+      IAT_CHECK(writer.cursor() < expected.size());
+
+      // The file stays open after a flush
+      IAT_CHECK(writer.flush().has_value());
+      auto partial = FileOps::read_binary_file(path);
+      IAT_CHECK(partial.has_value());
+      IAT_CHECK(*partial == expected);
+
+      IAT_CHECK(writer.write(0xCAFEBABEu).has_value());
+      expected.insert(expected.end(), {0xBE, 0xBA, 0xFE, 0xCA});
+    }
+
+    auto read_res = FileOps::read_binary_file(path);
+    IAT_CHECK(read_res.has_value());
+    IAT_CHECK(*read_res == expected);
+  }
+
+  std::filesystem::remove(path);
+
+  return true;
+}
+
 auto test_primitives() -> bool
 {
   StreamWriter writer;
@@ -108,11 +161,133 @@ auto test_primitives() -> bool
   return true;
 }
 
+auto test_growth_modes() -> bool
+{
+  Vec<u8> expected(10000);
+  for (usize i = 0; i < expected.size(); ++i)
+  {
+    expected[i] = static_cast<u8>(i * 13);
+  }
+
+  const auto concat = [](const StreamWriter &writer) {
+    Vec<u8> out;
+    for (const auto segment : writer.segments())
+    {
+      out.insert(out.end(), segment.begin(), segment.end());
+    }
+    return out;
+  };
+
+  {
+    StreamWriter writer({.initial_capacity = 0});
+    IAT_CHECK(writer.reserve(expected.size()).has_value());
+    const u8 *reserved = writer.data();
+    IAT_CHECK(writer.write(expected.data(), expected.size()).has_value());
+    IAT_CHECK_EQ(writer.data(), reserved);
+    IAT_CHECK(concat(writer) == expected);
+  }
+
+  alignas(std::max_align_t) static u8 arena_block[64 * 1024];
+  for (const bool use_arena : {false, true})
+  {
+    std::pmr::monotonic_buffer_resource arena(arena_block, sizeof(arena_block), std::pmr::null_memory_resource());
+
+    StreamWriter writer({.initial_capacity = 16,
+                         .segmented = true,
+                         .max_chunk_size = 1024,
+                         .arena = use_arena ? &arena : nullptr});
+
+    // Earlier chunks never move
+    IAT_CHECK(writer.write(expected.data(), 10).has_value());
+    const u8 *first_chunk = writer.data();
+
+    usize offset = 10;
+    IAT_CHECK(writer.write(expected.data() + offset, 3000).has_value());
+    offset += 3000;
+    IAT_CHECK(writer.write(expected[offset], 1).has_value());
+    offset += 1;
+    for (; offset + 7 <= expected.size(); offset += 7)
+    {
+      IAT_CHECK(writer.write(expected.data() + offset, 7).has_value());
+    }
+    IAT_CHECK(writer.write(expected.data() + offset, expected.size() - offset).has_value());
+
+    IAT_CHECK_EQ(writer.total_written(), expected.size());
+    IAT_CHECK(writer.segments().size() > 2);
+    IAT_CHECK_EQ(writer.cursor(), writer.segments().back().size());
+    IAT_CHECK_EQ(writer.segments()[0].data(), first_chunk);
+    IAT_CHECK(concat(writer) == expected);
+
+    StreamWriter moved = std::move(writer);
+    IAT_CHECK(concat(moved) == expected);
+    IAT_CHECK(moved.write(static_cast<u8>(0), 2000).has_value());
+    IAT_CHECK_EQ(moved.total_written(), expected.size() + 2000);
+  }
+
+  return true;
+}
+
+auto test_encodings() -> bool
+{
+  StreamWriter writer;
+
+  IAT_CHECK(writer.write_varint<u32>(300).has_value());
+  IAT_CHECK(writer.write_varint<u64>(0xFFFFFFFFFFFFFFFFull).has_value());
+  IAT_CHECK(writer.write_zigzag<i32>(-2).has_value());
+  IAT_CHECK(writer.write_zigzag<i64>(std::numeric_limits<i64>::min()).has_value());
+  IAT_CHECK(writer.write_be<u32>(0x11223344).has_value());
+  IAT_CHECK(writer.write_le<u16>(0xAABB).has_value());
+  IAT_CHECK(writer.write_be<f64>(1.25).has_value());
+
+  // Enough elements to need several swap chunks
+  Vec<u16> shorts(5000);
+  for (usize i = 0; i < shorts.size(); ++i)
+  {
+    shorts[i] = static_cast<u16>(i * 31);
+  }
+  IAT_CHECK(writer.write_array(Span<const u16>(shorts), std::endian::big).has_value());
+  IAT_CHECK(writer.write_array(Span<const u16>(shorts)).has_value());
+
+  const u8 *bytes = writer.data();
+  IAT_CHECK_EQ(bytes[0], 0xAC);
+  IAT_CHECK_EQ(bytes[1], 0x02);
+  IAT_CHECK_EQ(bytes[12], 0x03); // zigzag(-2) == 3
+
+  StreamReader reader(Span<const u8>(writer.data(), writer.cursor()));
+  IAT_CHECK_EQ(*reader.read_varint<u32>(), 300u);
+  IAT_CHECK_EQ(*reader.read_varint<u64>(), 0xFFFFFFFFFFFFFFFFull);
+  IAT_CHECK_EQ(*reader.read_zigzag<i32>(), -2);
+  IAT_CHECK_EQ(*reader.read_zigzag<i64>(), std::numeric_limits<i64>::min());
+
+  const usize be_pos = reader.cursor();
+  IAT_CHECK_EQ(bytes[be_pos], 0x11);
+  IAT_CHECK_EQ(*reader.read_be<u32>(), 0x11223344u);
+  IAT_CHECK_EQ(bytes[be_pos + 4], 0xBB);
+  IAT_CHECK_EQ(*reader.read_le<u16>(), 0xAABB);
+  IAT_CHECK_EQ(*reader.read_be<f64>(), 1.25);
+
+  const auto big = reader.read_array<u16>(shorts.size(), std::endian::big);
+  IAT_CHECK(big.has_value());
+  IAT_CHECK(*big == shorts);
+
+  Vec<u16> native(shorts.size());
+  IAT_CHECK(reader.read_array(Span<u16>(native)).has_value());
+  IAT_CHECK(native == shorts);
+
+  IAT_CHECK(reader.is_eof());
+  IAT_CHECK_NOT(reader.read_array<u16>(1).has_value());
+
+  return true;
+}
+
 IAT_BEGIN_TEST_LIST()
 IAT_ADD_TEST(test_memory_writer);
 IAT_ADD_TEST(test_fixed_buffer);
 IAT_ADD_TEST(test_file_writer);
+IAT_ADD_TEST(test_file_writer_streaming);
 IAT_ADD_TEST(test_primitives);
+IAT_ADD_TEST(test_growth_modes);
+IAT_ADD_TEST(test_encodings);
 IAT_END_TEST_LIST()
 
 IAT_END_BLOCK()
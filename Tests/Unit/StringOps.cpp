@@ -105,10 +105,73 @@ auto test_base64_round_trip() -> bool
   return true;
 }
 
+auto test_base64_large_and_url_safe() -> bool
+{
+  // Long enough for the block kernels, with every length mod 3 and every byte value
+  for (usize size = 0; size < 100; ++size)
+  {
+    Vec<u8> original(size * 7 + 1000);
+    for (usize i = 0; i < original.size(); ++i)
+    {
+      original[i] = static_cast<u8>(i * 131 + size);
+    }
+
+    const String encoded = StringOps::encode_base64(original);
+    IAT_CHECK_EQ(encoded.size(), (original.size() + 2) / 3 * 4);
+    IAT_CHECK(StringOps::decode_base64(encoded) == original);
+
+    const auto strict = StringOps::decode_base64(encoded, StringOps::Base64Alphabet::Standard);
+    IAT_CHECK(strict.has_value());
+    IAT_CHECK(*strict == original);
+
+    const String url = StringOps::encode_base64(original, StringOps::Base64Alphabet::UrlSafe, false);
+    IAT_CHECK(url.find_first_of("+/=") == String::npos);
+    const auto url_decoded = StringOps::decode_base64(url, StringOps::Base64Alphabet::UrlSafe);
+    IAT_CHECK(url_decoded.has_value());
+    IAT_CHECK(*url_decoded == original);
+  }
+
+  const String s = "\xFB\xFF\xBF";
+  const Span<const u8> data(reinterpret_cast<const u8 *>(s.data()), s.size());
+  IAT_CHECK_EQ(StringOps::encode_base64(data), String("+/+/"));
+  IAT_CHECK_EQ(StringOps::encode_base64(data, StringOps::Base64Alphabet::UrlSafe), String("-_-_"));
+
+  return true;
+}
+
+auto test_base64_strict_validation() -> bool
+{
+  using StringOps::Base64Alphabet::Standard;
+
+  const auto unpadded = StringOps::decode_base64("TWE", Standard);
+  IAT_CHECK(unpadded.has_value());
+  IAT_CHECK_EQ(unpadded->size(), static_cast<usize>(2));
+
+  IAT_CHECK_NOT(StringOps::decode_base64("TWE*", Standard).has_value());
+  IAT_CHECK_NOT(StringOps::decode_base64("T===", Standard).has_value());
+  IAT_CHECK_NOT(StringOps::decode_base64("TQ=A", Standard).has_value());
+  IAT_CHECK_NOT(StringOps::decode_base64("TWFuT", Standard).has_value());
+  IAT_CHECK_NOT(StringOps::decode_base64("TR==", Standard).has_value()); // Non-zero trailing bits
+  IAT_CHECK_NOT(StringOps::decode_base64("-_-_", Standard).has_value());
+
+  // An invalid character deep inside a SIMD-sized block
+  String long_input(64, 'A');
+  IAT_CHECK(StringOps::decode_base64(long_input, Standard).has_value());
+  long_input[37] = '\x80';
+  IAT_CHECK_NOT(StringOps::decode_base64(long_input, Standard).has_value());
+
+  // The lenient decoder stops there instead
+  IAT_CHECK_EQ(StringOps::decode_base64(long_input).size(), static_cast<usize>(27));
+
+  return true;
+}
+
 IAT_BEGIN_TEST_LIST()
 IAT_ADD_TEST(test_base64_encode);
 IAT_ADD_TEST(test_base64_decode);
 IAT_ADD_TEST(test_base64_round_trip);
+IAT_ADD_TEST(test_base64_large_and_url_safe);
+IAT_ADD_TEST(test_base64_strict_validation);
 IAT_END_TEST_LIST()
 
 IAT_END_BLOCK()
@@ -0,0 +1,175 @@
+// IACore-OSS; The Core Library for All IA Open Source Projects
+// Copyright (C) 2026 IAS (ias@iasoft.dev)
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <IACore/ADT/TimerWheel.hpp>
+#include <IACore/IATest.hpp>
+
+using namespace IACore;
+
+IAT_BEGIN_BLOCK(Core, TimerWheel)
+
+auto test_fire_order() -> bool
+{
+  TimerWheel<u64> wheel;
+
+  // Spread across every level, including ticks that land on cascade boundaries
+  const Vec<u64> expiries = {3, 1, 256, 255, 257, 16384, 70000, 1u << 20, 5};
+  for (const u64 expiry : expiries)
+  {
+    wheel.schedule(expiry, u64{expiry});
+  }
+  IAT_CHECK_EQ(wheel.size(), expiries.size());
+
+  Vec<std::pair<u64, u64>> fired;
+  wheel.advance(1u << 21, [&](TimerWheel<u64>::TimerId, MutRef<u64> payload) -> Option<u64> {
+    fired.emplace_back(wheel.current_tick(), payload);
+    return std::nullopt;
+  });
+
+  IAT_CHECK_EQ(fired.size(), expiries.size());
+  IAT_CHECK(wheel.empty());
+
+  for (usize i = 0; i < fired.size(); ++i)
+  {
+    IAT_CHECK_EQ(fired[i].first, fired[i].second);
+    if (i > 0)
+    {
+      IAT_CHECK(fired[i - 1].second <= fired[i].second);
+    }
+  }
+
+  return true;
+}
+
+auto test_cancel() -> bool
+{
+  TimerWheel<String> wheel;
+
+  const auto a = wheel.schedule(10, String("a"));
+  const auto b = wheel.schedule(20, String("b"));
+  IAT_CHECK(a != TimerWheel<String>::INVALID_TIMER_ID);
+
+  const auto cancelled = wheel.cancel(a);
+  IAT_CHECK(cancelled.has_value());
+  IAT_CHECK_EQ(*cancelled, String("a"));
+  IAT_CHECK_NOT(wheel.cancel(a).has_value());
+  IAT_CHECK_NOT(wheel.cancel(TimerWheel<String>::INVALID_TIMER_ID).has_value());
+
+  // A recycled slot must not be reachable through the stale id
+  const auto c = wheel.schedule(30, String("c"));
+  IAT_CHECK(c != a);
+  IAT_CHECK_NOT(wheel.cancel(a).has_value());
+
+  Vec<String> fired;
+  wheel.advance(100, [&](TimerWheel<String>::TimerId, MutRef<String> payload) -> Option<u64> {
+    fired.push_back(payload);
+    return std::nullopt;
+  });
+
+  IAT_CHECK_EQ(fired.size(), static_cast<usize>(2));
+  IAT_CHECK_EQ(fired[0], String("b"));
+  IAT_CHECK_EQ(fired[1], String("c"));
+  IAT_CHECK_NOT(wheel.cancel(b).has_value());
+
+  return true;
+}
+
+auto test_rearm() -> bool
+{
+  TimerWheel<u32> wheel;
+
+  const auto id = wheel.schedule(100, 0u);
+
+  u32 count = 0;
+  bool on_schedule = true;
+  wheel.advance(1000, [&](TimerWheel<u32>::TimerId fired_id, MutRef<u32> payload) -> Option<u64> {
+    on_schedule = on_schedule && fired_id == id && wheel.current_tick() == static_cast<u64>(100 * (payload + 1));
+    payload++;
+    count++;
+    return wheel.current_tick() + 100;
+  });
+
+  IAT_CHECK(on_schedule);
+  IAT_CHECK_EQ(count, 10u);
+  IAT_CHECK_EQ(wheel.size(), static_cast<usize>(1));
+  IAT_CHECK(wheel.cancel(id).has_value());
+
+  return true;
+}
+
+auto test_next_event_tick() -> bool
+{
+  TimerWheel<u32> wheel(1000);
+  IAT_CHECK_NOT(wheel.next_event_tick().has_value());
+
+  wheel.schedule(1050, 0u);
+  IAT_CHECK_EQ(*wheel.next_event_tick(), static_cast<u64>(1050));
+
+  // Already due timers fire on the next tick
+  wheel.schedule(10, 0u);
+  IAT_CHECK_EQ(*wheel.next_event_tick(), static_cast<u64>(1001));
+
+  usize drained = 0;
+  wheel.drain([&](MutRef<u32>) { drained++; });
+  IAT_CHECK_EQ(drained, static_cast<usize>(2));
+  IAT_CHECK(wheel.empty());
+
+  return true;
+}
+
+auto test_many_timers() -> bool
+{
+  TimerWheel<u32> wheel;
+
+  constexpr u32 COUNT = 200000;
+  Vec<TimerWheel<u32>::TimerId> ids;
+  ids.reserve(COUNT);
+  for (u32 i = 0; i < COUNT; ++i)
+  {
+    ids.push_back(wheel.schedule(1 + (static_cast<u64>(i) * 7919) % 500000, u32{i}));
+  }
+
+  for (u32 i = 0; i < COUNT; i += 2)
+  {
+    IAT_CHECK(wheel.cancel(ids[i]).has_value());
+  }
+
+  u64 last_tick = 0;
+  bool in_order = true;
+  const usize fired = wheel.advance(500000, [&](TimerWheel<u32>::TimerId, MutRef<u32> payload) -> Option<u64> {
+    in_order = in_order && (payload % 2 == 1) && wheel.current_tick() >= last_tick &&
+               wheel.current_tick() == 1 + (static_cast<u64>(payload) * 7919) % 500000;
+    last_tick = wheel.current_tick();
+    return std::nullopt;
+  });
+
+  IAT_CHECK(in_order);
+  IAT_CHECK_EQ(fired, static_cast<usize>(COUNT / 2));
+  IAT_CHECK(wheel.empty());
+
+  return true;
+}
+
+IAT_BEGIN_TEST_LIST()
+IAT_ADD_TEST(test_fire_order);
+IAT_ADD_TEST(test_cancel);
+IAT_ADD_TEST(test_rearm);
+IAT_ADD_TEST(test_next_event_tick);
+IAT_ADD_TEST(test_many_timers);
+IAT_END_TEST_LIST()
+
+IAT_END_BLOCK()
+
+IAT_REGISTER_ENTRY(Core, TimerWheel)
@@ -60,6 +60,53 @@ auto test_hex_conversion() -> bool
   return true;
 }
 
+auto test_hex_large_and_into() -> bool
+{
+  Vec<u8> original(1000);
+  for (usize i = 0; i < original.size(); ++i)
+  {
+    original[i] = static_cast<u8>(i * 37 + 11);
+  }
+
+  // Odd sizes exercise the scalar tail after the 16 byte blocks
+  for (usize size : {usize(0), usize(15), usize(16), usize(17), usize(33), usize(1000)})
+  {
+    const Span<const u8> data(original.data(), size);
+
+    const String upper = Utils::binary_to_hex_string(data);
+    const String lower = Utils::binary_to_hex_string(data, Utils::HexCase::Lower);
+    IAT_CHECK_EQ(upper.size(), size * 2);
+    IAT_CHECK(upper.find_first_of("abcdef") == String::npos);
+    IAT_CHECK(lower.find_first_of("ABCDEF") == String::npos);
+
+    const auto from_upper = Utils::hex_string_to_binary(upper);
+    const auto from_lower = Utils::hex_string_to_binary(lower);
+    IAT_CHECK(from_upper.has_value() && from_lower.has_value());
+    IAT_CHECK(std::ranges::equal(*from_upper, data));
+    IAT_CHECK(std::ranges::equal(*from_lower, data));
+  }
+
+  Array<char, 8> chars{};
+  const u8 word[] = {0x01, 0xAB, 0xCD, 0xEF};
+  IAT_CHECK_EQ(*Utils::binary_to_hex(word, chars, Utils::HexCase::Lower), static_cast<usize>(8));
+  IAT_CHECK_EQ(StringView(chars.data(), chars.size()), StringView("01abcdef"));
+  IAT_CHECK_NOT(Utils::binary_to_hex(word, Span<char>(chars.data(), 7)).has_value());
+
+  Array<u8, 4> bytes{};
+  IAT_CHECK_EQ(*Utils::hex_to_binary("01AbcDeF", bytes), static_cast<usize>(4));
+  IAT_CHECK(std::ranges::equal(bytes, word));
+  IAT_CHECK_NOT(Utils::hex_to_binary("0011223344", bytes).has_value());
+
+  // An invalid character inside a full SIMD block
+  String hex = Utils::binary_to_hex_string(original);
+  hex[45] = 'g';
+  IAT_CHECK_NOT(Utils::hex_string_to_binary(hex).has_value());
+  hex[45] = '/';
+  IAT_CHECK_NOT(Utils::hex_string_to_binary(hex).has_value());
+
+  return true;
+}
+
 auto test_hex_errors() -> bool
 {
 
@@ -159,6 +206,7 @@ auto test_hash_macro() -> bool
 IAT_BEGIN_TEST_LIST()
 IAT_ADD_TEST(test_hex_conversion);
 IAT_ADD_TEST(test_hex_errors);
+IAT_ADD_TEST(test_hex_large_and_into);
 IAT_ADD_TEST(test_sort);
 IAT_ADD_TEST(test_binary_search);
 IAT_ADD_TEST(test_hash_basics);